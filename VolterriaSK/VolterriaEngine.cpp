@@ -9,34 +9,198 @@
 // VolterriaEngine.cpp
 #include "VolterriaEngine.hpp"
 
+#include <cmath>
+
 // You’ll adapt these calls to whatever Field actually exposes.
 VolterriaEngine::VolterriaEngine()
     : field_(Settings{}) // maybe pass Settings, etc.
 {
     // TODO: initialize grass, population, etc. as needed
+    configureHistory();
+}
+
+VolterriaEngine::VolterriaEngine(const Settings& settings)
+    : field_(settings)
+{
+    configureHistory();
 }
 
 void VolterriaEngine::ResetSimulation()
 {
     field_.ResetFromSettings();
+    rate_fit_.clear();
+    configureHistory(); // also drops the previous run's history
+    publishFrame();
+}
+
+void VolterriaEngine::WarmReset()
+{
+    field_.WarmReset();
+    rate_fit_.clear();
+    history_.clear();
+    publishFrame();
+}
+
+void VolterriaEngine::Reconfigure(const Settings& settings)
+{
+    const Settings old = field_.settings();
+    field_.Reconfigure(settings);
+    rate_fit_.clear();
+    if (settings.history_keyframe_interval != old.history_keyframe_interval
+        || settings.history_budget_mb != old.history_budget_mb)
+        configureHistory();
+    else
+        history_.clear();
+    publishFrame();
+}
+
+void VolterriaEngine::configureHistory()
+{
+    const Settings& s = field_.settings();
+    history_.configure(s.history_keyframe_interval,
+                       static_cast<std::size_t>(std::max(s.history_budget_mb, 0)) << 20);
 }
 
 void VolterriaEngine::step(double dt) {
-    field_.step(static_cast<float>(dt)); // or however your Field steps
+    const float fdt = static_cast<float>(dt);
+    history_.record(field_, fdt);
+    field_.step(fdt); // or however your Field steps
+    if (rate_fit_.active())
+    {
+        int prey, predators;
+        field_.populationCounts(&prey, &predators);
+        rate_fit_.sample(dt, prey, predators);
+    }
+    publishFrame();
+}
+
+bool VolterriaEngine::seekToStep(int64_t step)
+{
+    if (step < 0) return false;
+    if (!history_.seek(field_, static_cast<uint64_t>(step))) return false;
+    rate_fit_.clear(); // its window no longer matches what happened
+    publishFrame();
+    return true;
+}
+
+void VolterriaEngine::beginRateFit()
+{
+    rate_fit_.begin(field_.tallies());
+}
+
+std::vector<VPopulationSample> VolterriaEngine::fastForward(double seconds, double odeStep)
+{
+    std::vector<VPopulationSample> out;
+    const Settings& settings = field_.settings();
+    MeanFieldRates rates;
+    const double min_window = std::max(settings.prey_max_age, settings.pred_max_age);
+    if (seconds <= 0.0 || !rate_fit_.fit(field_.tallies(), settings.mean_field_prey_capacity, min_window, &rates))
+        return out;
+    mean_field_rates_ = { rates.prey_birth, rates.prey_death, rates.predation,
+                          rates.predator_birth, rates.predator_death };
+
+    int prey, predators;
+    field_.populationCounts(&prey, &predators);
+    std::vector<PopulationSample> curve;
+    const PopulationSample end = integrateMeanField(rates, {field_.simTime(), double(prey), double(predators)},
+                                                    seconds, odeStep, &curve);
+
+    // The model has no ceiling of its own (unbounded prey growth without a
+    // capacity), so cap what gets materialized as agents.
+    const double cap = std::max(settings.mean_field_max_population, 0);
+    auto materialize = [cap](double count)
+    {
+        return count > 0.0 ? static_cast<int>(std::lround(std::min(count, cap))) : 0; // NaN -> 0
+    };
+    field_.jumpAhead(seconds, materialize(end.prey), materialize(end.predators));
+    configureHistory(); // the skipped span can't be replayed
+    rate_fit_.clear();
+    publishFrame();
+
+    out.reserve(curve.size());
+    for (const PopulationSample& p : curve)
+        out.push_back({p.time, p.prey, p.predators});
+    return out;
+}
+
+bool VolterriaEngine::EnableSharedMemory(const std::string& name, int maxCreatures, int maxGrassPatches)
+{
+    // Drop the old publisher first: create() replaces a segment of the
+    // same name, which the old one would otherwise unlink on destruction.
+    publisher_.reset();
+    publisher_ = SnapshotPublisher::create(name, static_cast<std::size_t>(std::max(maxCreatures, 0)),
+                                           static_cast<std::size_t>(std::max(maxGrassPatches, 0)));
+    if (!publisher_) return false;
+    publishFrame();
+    return true;
+}
+
+void VolterriaEngine::publishFrame()
+{
+    if (!publisher_) return;
+    refreshSnapshots();
+    publisher_->publish(creature_snapshot_, grass_snapshot_, field_.stepCount(), field_.simTime());
 }
 
 std::vector<VCreatureSnapshot> VolterriaEngine::creatureSnapshot() const {
     std::vector<VCreatureSnapshot> out;
-    const auto& creatures = field_.creatures(); // adjust to your API
+    fillCreatureSnapshot(out);
+    return out;
+}
 
-    out.reserve(creatures.size());
-    for (std::size_t i = 0; i < creatures.size(); ++i) {
-        const Creature &c = creatures[i];
-        if(!c.isAlive())
+std::vector<VGrassPatchSnapshot> VolterriaEngine::grassSnapshot() const {
+    std::vector<VGrassPatchSnapshot> out;
+    fillGrassSnapshot(out);
+    return out;
+}
+
+void VolterriaEngine::refreshSnapshots()
+{
+    fillCreatureSnapshot(creature_snapshot_);
+    fillGrassSnapshot(grass_snapshot_);
+}
+
+void VolterriaEngine::refreshArrays()
+{
+    const auto& creatures = field_.creatures();
+    const auto& patches = field_.grassPatches();
+    const std::size_t n = creatures.size();
+
+    // resize() only reallocates when the population outgrows the buffers
+    arrays_.id.resize(n);
+    arrays_.position.resize(2 * n);
+    arrays_.hunger.resize(n);
+    arrays_.age.resize(n);
+    arrays_.role.resize(n);
+
+    std::size_t k = 0;
+    for (const Creature& c : creatures) {
+        if (!c.isAlive())
             continue;
+        arrays_.id[k] = static_cast<int32_t>(c.id());
+        arrays_.position[2 * k] = c.position().x;
+        arrays_.position[2 * k + 1] = c.position().y;
+        arrays_.hunger[k] = c.normalizedHunger();
+        arrays_.age[k] = c.age();
+        arrays_.role[k] = static_cast<int32_t>(c.species());
+        ++k;
+    }
+    arrays_.id.resize(k);
+    arrays_.position.resize(2 * k);
+    arrays_.hunger.resize(k);
+    arrays_.age.resize(k);
+    arrays_.role.resize(k);
+
+    arrays_.grassHealth.resize(patches.size());
+    for (std::size_t i = 0; i < patches.size(); ++i)
+        arrays_.grassHealth[i] = patches[i].health;
+}
+
+namespace {
+    VCreatureSnapshot makeCreatureSnapshot(const Creature& c) {
         VCreatureSnapshot s;
         //s.id = static_cast<int32_t>(i);
-        s.id = c.id(); // get unique, monotonically increasing id to prevent sync issues with SpriteKit
+        s.id = c.id(); // generational handle: unique among the living; a dead creature's id only recurs after 2047 reuses of its slot
         s.x = c.position().x;
         s.y = c.position().y;
         s.role = (c.species() == SpeciesRole::Prey)
@@ -47,18 +211,10 @@ std::vector<VCreatureSnapshot> VolterriaEngine::creatureSnapshot() const {
         s.normalizedHunger = c.normalizedHunger();
         s.age = c.age();
         s.normalizedAge = c.normalizedAge();
-        out.push_back(s);
+        return s;
     }
-    return out;
-}
 
-std::vector<VGrassPatchSnapshot> VolterriaEngine::grassSnapshot() const {
-    std::vector<VGrassPatchSnapshot> out;
-    const auto& patches = field_.grassPatches(); // adjust to your API
-
-    out.reserve(patches.size());
-    for (std::size_t i = 0; i < patches.size(); ++i) {
-        const GrassPatch &g = patches[i];
+    VGrassPatchSnapshot makeGrassSnapshot(const GrassPatch& g, std::size_t i) {
         VGrassPatchSnapshot s;
         s.id = static_cast<int32_t>(i);
         s.x = g.center.x;
@@ -66,11 +222,124 @@ std::vector<VGrassPatchSnapshot> VolterriaEngine::grassSnapshot() const {
         s.radius = g.radius;
         s.normalizedHealth = g.healthNormalized();
         s.health = g.health;
-        out.push_back(s);
+        return s;
+    }
+}
+
+void VolterriaEngine::fillCreatureSnapshot(std::vector<VCreatureSnapshot>& out) const {
+    const auto& creatures = field_.creatures(); // adjust to your API
+
+    out.clear(); // keeps capacity
+    out.reserve(creatures.size());
+    for (std::size_t i = 0; i < creatures.size(); ++i) {
+        const Creature &c = creatures[i];
+        if(!c.isAlive())
+            continue;
+        out.push_back(makeCreatureSnapshot(c));
+    }
+}
+
+void VolterriaEngine::fillGrassSnapshot(std::vector<VGrassPatchSnapshot>& out) const {
+    const auto& patches = field_.grassPatches(); // adjust to your API
+
+    out.clear(); // keeps capacity
+    out.reserve(patches.size());
+    for (std::size_t i = 0; i < patches.size(); ++i)
+        out.push_back(makeGrassSnapshot(patches[i], i));
+}
+
+void VolterriaEngine::fillSnapshotsInRect(float xMin, float yMin, float xMax, float yMax,
+                                          std::vector<int>& indices,
+                                          std::vector<VCreatureSnapshot>* creaturesOut,
+                                          std::vector<VGrassPatchSnapshot>* grassOut) const {
+    if (creaturesOut) {
+        const auto& creatures = field_.creatures();
+        field_.queryCreaturesInRect(xMin, yMin, xMax, yMax, indices);
+        creaturesOut->clear();
+        for (int i : indices)
+            creaturesOut->push_back(makeCreatureSnapshot(creatures[i]));
+    }
+    if (grassOut) {
+        const auto& patches = field_.grassPatches();
+        field_.queryGrassInRect(xMin, yMin, xMax, yMax, indices);
+        grassOut->clear();
+        for (int i : indices)
+            grassOut->push_back(makeGrassSnapshot(patches[i], i));
+    }
+}
+
+std::vector<VCreatureSnapshot> VolterriaEngine::creatureSnapshotInRect(float xMin, float yMin, float xMax, float yMax) const {
+    std::vector<VCreatureSnapshot> out;
+    std::vector<int> indices;
+    fillSnapshotsInRect(xMin, yMin, xMax, yMax, indices, &out, nullptr);
+    return out;
+}
+
+std::vector<VGrassPatchSnapshot> VolterriaEngine::grassSnapshotInRect(float xMin, float yMin, float xMax, float yMax) const {
+    std::vector<VGrassPatchSnapshot> out;
+    std::vector<int> indices;
+    fillSnapshotsInRect(xMin, yMin, xMax, yMax, indices, nullptr, &out);
+    return out;
+}
+
+void VolterriaEngine::refreshSnapshotsInRect(float xMin, float yMin, float xMax, float yMax)
+{
+    fillSnapshotsInRect(xMin, yMin, xMax, yMax, query_indices_, &creature_snapshot_, &grass_snapshot_);
+}
+
+std::vector<VHeatmapBin> VolterriaEngine::densityHeatmap(int width, int height) const
+{
+    std::vector<HeatmapBin> bins;
+    field_.densityHeatmap(width, height, bins);
+
+    std::vector<VHeatmapBin> out;
+    out.reserve(bins.size());
+    for (const HeatmapBin& b : bins)
+        out.push_back({b.prey, b.predators, b.mean_hunger, b.mean_age});
+    return out;
+}
+
+std::vector<VNodeLoad> VolterriaEngine::nodeLoad() const
+{
+    std::vector<VNodeLoad> out;
+    for (const NodeLoad& n : field_.nodeLoad())
+        out.push_back({static_cast<int64_t>(n.tasks), static_cast<int64_t>(n.weight), static_cast<int64_t>(n.remote_tasks)});
+    return out;
+}
+
+void VolterriaEngine::EnableEventStream(int capacity)
+{
+    field_.EnableEvents(static_cast<std::size_t>(capacity));
+}
+
+std::vector<VFieldEvent> VolterriaEngine::drainEvents(int maxEvents)
+{
+    std::vector<VFieldEvent> out;
+    const auto queue = field_.eventQueue();
+    if (!queue) return out;
+
+    FieldEvent e;
+    while ((int)out.size() < maxEvents && queue->tryPop(e)) {
+        VFieldEvent v;
+        v.type = static_cast<VFieldEventType>(e.type);
+        v.id = static_cast<int32_t>(e.subject);
+        v.otherId = static_cast<int32_t>(e.other);
+        v.otherId2 = static_cast<int32_t>(e.other2);
+        v.role = (e.species == SpeciesRole::Prey) ? VSpeciesRole::Prey : VSpeciesRole::Predator;
+        v.x = e.x;
+        v.y = e.y;
+        v.time = e.time;
+        out.push_back(v);
     }
     return out;
 }
 
+int VolterriaEngine::droppedEvents() const
+{
+    const auto queue = field_.eventQueue();
+    return queue ? static_cast<int>(queue->dropped()) : 0;
+}
+
 //void VolterriaEngine::setDefaultPopulation(int prey, int pred) {
 //    field_.resetPopulation(prey, pred); // you’ll hook this to whatever you have
 //}
@@ -86,14 +355,17 @@ void VolterriaEngine::SetDefaultPopulation(int prey, int pred)
 void VolterriaEngine::SetWorldDimensions(float width, float height)
 {
     field_.SetFieldDimensions(width, height);
+    history_.clear();
 }
 
 void VolterriaEngine::SetFieldWidth(float width)
 {
     field_.SetFieldWidth(width);
+    history_.clear();
 }
 
 void VolterriaEngine::SetFieldHeight(float height)
 {
     field_.SetFieldHeight(height);
+    history_.clear();
 }
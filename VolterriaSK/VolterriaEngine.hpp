@@ -9,9 +9,14 @@
 
 #include <vector>
 #include <cstdint>
+#include <memory>
+#include <string>
 
 #include "field.hpp"
 #include "creature.hpp"
+#include "rewind_buffer.hpp"
+#include "snapshot_shm.hpp"
+#include "mean_field.hpp"
 
 // Match your existing Swift roles
 enum class VSpeciesRole : int {
@@ -24,6 +29,25 @@ enum class VSex : int {
     Female = 1, // Swift: .Female
 };
 
+enum class VFieldEventType : int {
+    Born = 0,
+    Eaten = 1,
+    Starved = 2,
+    DiedOfAge = 3,
+    Mated = 4,
+};
+
+struct VFieldEvent {
+    VFieldEventType type;
+    int32_t id;      // creature the event is about
+    int32_t otherId; // predator (Eaten), mate (Mated), first parent (Born)
+    int32_t otherId2; // second parent (Born)
+    VSpeciesRole role;
+    float x;
+    float y;
+    float time;
+};
+
 struct VGrassPatchSnapshot {
     int32_t id;
     float x;
@@ -45,11 +69,61 @@ struct VCreatureSnapshot {
     float normalizedAge;
 };
 
+struct VHeatmapBin {
+    float prey;
+    float predators;
+    float meanHunger; // normalized 0.0 – 1.0
+    float meanAge;    // normalized 0.0 – 1.0
+};
+
+// Fitted per-capita rates of the mean-field model (see mean_field.hpp),
+// per second.
+struct VMeanFieldRates {
+    double preyBirth;     // per prey
+    double preyDeath;     // starvation + old age, per prey
+    double predation;     // prey eaten, per prey per predator
+    double predatorBirth; // per prey per predator
+    double predatorDeath; // starvation + old age, per predator
+};
+
+struct VPopulationSample {
+    double time; // sim seconds
+    double prey;
+    double predators;
+};
+
+// Work done by one NUMA node's workers (or the whole pool) last step.
+struct VNodeLoad {
+    int64_t tasks;       // tiles and update ranges run
+    int64_t weight;      // creatures they covered
+    int64_t remoteTasks; // of those, homed on another node
+};
+
+// Structure-of-arrays copy of the live population and grass, one
+// contiguous buffer per quantity. Rewritten in place by refreshArrays(),
+// so bulk consumers (the Python bindings hand these out as NumPy views)
+// read engine-owned memory instead of copying snapshot structs. The next
+// refreshArrays() may reallocate them, so views do not survive it.
+struct VEngineArrays {
+    std::vector<int32_t> id;
+    std::vector<float> position; // interleaved x, y
+    std::vector<float> hunger;   // normalized 0.0 – 1.0
+    std::vector<float> age;      // sim seconds
+    std::vector<int32_t> role;   // VSpeciesRole values
+    std::vector<float> grassHealth;
+};
+
 // High-level C++ engine wrapper around Field
 class VolterriaEngine {
 public:
     VolterriaEngine();
+    explicit VolterriaEngine(const Settings& settings);
     void ResetSimulation();
+    // Quiet reset that reuses the Field's buffers (see Field::WarmReset).
+    void WarmReset();
+    // New settings mid-run, population kept (see Field::Reconfigure).
+    // History is dropped: its keyframes were taken under the old settings.
+    void Reconfigure(const Settings& settings);
 
     // Keep the old name so Swift calls can stay almost identical
     void step(double dt);
@@ -58,13 +132,78 @@ public:
     std::vector<VCreatureSnapshot> creatureSnapshot() const;
     std::vector<VGrassPatchSnapshot> grassSnapshot() const;
 
-    // Settings setters
+    // Engine-owned snapshot buffers. refreshSnapshots() rewrites them in place
+    // and keeps their capacity, so steady-state frames don't touch the heap.
+    void refreshSnapshots();
+    const std::vector<VCreatureSnapshot>& creatureSnapshotBuffer() const noexcept { return creature_snapshot_; }
+    const std::vector<VGrassPatchSnapshot>& grassSnapshotBuffer() const noexcept { return grass_snapshot_; }
+
+    // Viewport-culled variants: only the creatures and grass patches inside
+    // the world-space rectangle, looked up through the Field's spatial grid
+    // so the cost follows the visible cells rather than the population.
+    std::vector<VCreatureSnapshot> creatureSnapshotInRect(float xMin, float yMin, float xMax, float yMax) const;
+    std::vector<VGrassPatchSnapshot> grassSnapshotInRect(float xMin, float yMin, float xMax, float yMax) const;
+    void refreshSnapshotsInRect(float xMin, float yMin, float xMax, float yMax);
+
+    // Level-of-detail product for zoomed-out views: per-bin prey/predator
+    // counts and mean hunger/age over the whole world, row-major with y as
+    // the outer index. Computed during the grid rebuild, so this is only a
+    // merge of cell totals. Resolution is capped at the grid's.
+    std::vector<VHeatmapBin> densityHeatmap(int width, int height) const;
+
+    // Same idea for the structure-of-arrays layout.
+    void refreshArrays();
+    const VEngineArrays& arrays() const noexcept { return arrays_; }
+
+    // Event stream: births, deaths and predation, pushed by step() into a
+    // lock-free queue. drainEvents() pops up to maxEvents of them.
+    void EnableEventStream(int capacity);
+    std::vector<VFieldEvent> drainEvents(int maxEvents);
+    int droppedEvents() const;
+
+    // Out-of-process viewers: once enabled, every step() (and seek) ends by
+    // writing the snapshot buffers into the named POSIX shared-memory
+    // segment, which readers attach to with SnapshotReader. The sim never
+    // waits on them. Capacities are fixed here; larger frames are truncated.
+    bool EnableSharedMemory(const std::string& name, int maxCreatures, int maxGrassPatches);
+    void DisableSharedMemory() { publisher_.reset(); }
+
+    // Rewind. With history_budget_mb set, step() records keyframes plus
+    // per-step dts; seekToStep() jumps to any retained step (cost bounded by
+    // the keyframe interval) and later steps continue from there, replacing
+    // the old future. Steps count from the last reset. With neighbor_lists
+    // on, keyframes carry the lists too (replay has to see the same pair
+    // order), which in a crowded world can be most of their size.
+    bool seekToStep(int64_t step);
+    int64_t currentStep() const noexcept { return static_cast<int64_t>(field_.stepCount()); }
+    int64_t oldestRetainedStep() const noexcept { return history_.empty() ? currentStep() : static_cast<int64_t>(history_.oldestStep()); }
+    int64_t historyBytes() const noexcept { return static_cast<int64_t>(history_.bytesInUse()); }
+
+    // Mean-field fast-forward. beginRateFit() opens a window; step() as
+    // usual for a while so the window sees births, predation and deaths;
+    // then fastForward() fits Lotka–Volterra rates from it, integrates the
+    // counts `seconds` ahead with RK4 steps of odeStep, and resumes agents:
+    // the population is resampled from the current one to the predicted
+    // counts (capped at Settings::mean_field_max_population), keeping its
+    // spatial distribution. Returns the predicted curve, or nothing if the
+    // window can't support a fit: no prey, shorter than either species'
+    // max age, or too few events behind some rate (see MeanFieldFit).
+    // History is dropped, since the skipped span can't be replayed.
+    void beginRateFit();
+    std::vector<VPopulationSample> fastForward(double seconds, double odeStep);
+    bool rateFitActive() const noexcept { return rate_fit_.active(); }
+    double rateFitWindow() const noexcept { return rate_fit_.window(); }
+    VMeanFieldRates meanFieldRates() const noexcept { return mean_field_rates_; } // of the last fastForward()
+
+    // Settings setters. The world-size ones resize the running world and
+    // drop rewind history.
     void SetDefaultPopulation(int prey, int pred);
     void SetWorldDimensions(float width, float height);
     void SetFieldWidth(float width);
     void SetFieldHeight(float height);
 
     // Settings getters
+    const Settings& settings() const noexcept { return field_.settings(); }
     std::size_t defaultPreyPop() const noexcept { return field_.settings().numprey; }
     std::size_t defaultPredatorPop() const noexcept { return field_.settings().numpred; }
     float maxPreyAge() const noexcept { return field_.settings().prey_max_age; }
@@ -79,7 +218,35 @@ public:
     // Miscellaneous
     int elapsedSimSeconds() const noexcept { return field_.elapsedSimSeconds(); }
     int pairChecksPerFrame() const noexcept { return field_.pairChecksPerFrame(); }
+    float gridCellSize() const noexcept { return field_.cellSize(); }
     float framesPerSecond() const noexcept { return field_.framesPerSecond(); }
+    std::vector<VNodeLoad> nodeLoad() const;
+    
+    // Dense grass (Settings::grass_raster): cell health, row-major with y
+    // as the outer index; empty otherwise. The Field's own buffer, so it
+    // changes as the simulation steps.
+    const std::vector<float>& grassRaster() const noexcept { return field_.grassRaster().health(); }
+    int grassRasterCols() const noexcept { return field_.grassRaster().cols(); }
+    int grassRasterRows() const noexcept { return field_.grassRaster().rows(); }
+    float grassRasterCellSize() const noexcept { return field_.grassRaster().cellSize(); }
 private:
+    void fillCreatureSnapshot(std::vector<VCreatureSnapshot>& out) const;
+    void fillGrassSnapshot(std::vector<VGrassPatchSnapshot>& out) const;
+    void fillSnapshotsInRect(float xMin, float yMin, float xMax, float yMax,
+                             std::vector<int>& indices,
+                             std::vector<VCreatureSnapshot>* creaturesOut,
+                             std::vector<VGrassPatchSnapshot>* grassOut) const;
+
+    void configureHistory();
+    void publishFrame();
+
     Field field_;
+    RewindBuffer history_;
+    std::shared_ptr<SnapshotPublisher> publisher_; // null unless shared memory is enabled
+    MeanFieldFit rate_fit_;
+    VMeanFieldRates mean_field_rates_{};
+    std::vector<VCreatureSnapshot> creature_snapshot_;
+    std::vector<VGrassPatchSnapshot> grass_snapshot_;
+    VEngineArrays arrays_;
+    std::vector<int> query_indices_; // scratch for refreshSnapshotsInRect
 };
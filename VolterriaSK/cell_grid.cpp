@@ -0,0 +1,136 @@
+//
+//  cell_grid.cpp
+//  Volterria
+//
+//  Created by Devin R Cohen on 10/18/26.
+//
+
+#include "cell_grid.hpp"
+
+#include <algorithm>
+
+void CellGrid::configure(int num_cells_x, int num_cells_y, bool sparse)
+{
+    // Same shape: just empty it, so the cells keep their capacity.
+    if (sparse == sparse_ && num_cells_x == nx_ && num_cells_y == ny_ && (sparse_ ? !table_.empty() : !pool_.empty()))
+    {
+        clear();
+        return;
+    }
+    sparse_ = sparse;
+    nx_ = num_cells_x;
+    ny_ = num_cells_y;
+    used_ = 0;
+    stamp_ = 1;
+    if (!sparse_)
+    {
+        pool_.assign(static_cast<std::size_t>(nx_) * ny_, FieldCell{});
+        stats_.assign(pool_.size(), CellStats{});
+        pool_x_.clear();
+        pool_y_.clear();
+        table_.clear();
+        return;
+    }
+    pool_.clear();
+    stats_.clear();
+    pool_x_.clear();
+    pool_y_.clear();
+    table_.assign(64, Slot{0, 0, 0});
+}
+
+void CellGrid::clear()
+{
+    if (!sparse_)
+    {
+        for (FieldCell& cell : pool_)
+        {
+            cell.cell_creatures_indices.clear();
+            cell.cell_grassPatches_indices.clear();
+        }
+        std::fill(stats_.begin(), stats_.end(), CellStats{});
+        return;
+    }
+
+    // Only the cells handed out since the last clear need emptying; the
+    // table forgets them all at once through the stamp.
+    for (std::size_t i = 0; i < used_; ++i)
+    {
+        pool_[i].cell_creatures_indices.clear();
+        pool_[i].cell_grassPatches_indices.clear();
+        stats_[i] = CellStats{};
+    }
+    used_ = 0;
+    if (++stamp_ == 0)
+    {
+        // Wrapped: old stamps could read as live again.
+        std::fill(table_.begin(), table_.end(), Slot{0, 0, 0});
+        stamp_ = 1;
+    }
+}
+
+int CellGrid::lookup(int cx, int cy) const
+{
+    if (cx < 0 || cx >= nx_ || cy < 0 || cy >= ny_) return -1;
+    if (!sparse_) return cx * ny_ + cy;
+
+    const uint64_t key = keyOf(cx, cy);
+    const std::size_t mask = table_.size() - 1;
+    for (std::size_t i = hashOf(key) & mask;; i = (i + 1) & mask)
+    {
+        const Slot& s = table_[i];
+        if (s.stamp != stamp_) return -1;
+        if (s.key == key) return static_cast<int>(s.cell);
+    }
+}
+
+uint32_t CellGrid::acquire(int cx, int cy)
+{
+    if (!sparse_) return static_cast<uint32_t>(cx * ny_ + cy);
+
+    if (2 * (used_ + 1) > table_.size())
+        grow();
+
+    const uint64_t key = keyOf(cx, cy);
+    const std::size_t mask = table_.size() - 1;
+    std::size_t i = hashOf(key) & mask;
+    for (;; i = (i + 1) & mask)
+    {
+        Slot& s = table_[i];
+        if (s.stamp != stamp_) break;
+        if (s.key == key) return s.cell;
+    }
+
+    // New cell: reuse a pooled one if there is one, so its vectors keep
+    // the capacity they grew to.
+    const uint32_t cell = static_cast<uint32_t>(used_++);
+    if (cell == pool_.size())
+    {
+        pool_.emplace_back();
+        stats_.emplace_back();
+        pool_x_.push_back(cx);
+        pool_y_.push_back(cy);
+    }
+    else
+    {
+        pool_x_[cell] = cx;
+        pool_y_[cell] = cy;
+    }
+    table_[i] = {key, cell, stamp_};
+    return cell;
+}
+
+void CellGrid::grow()
+{
+    std::vector<Slot> old;
+    old.swap(table_);
+    table_.assign(old.size() * 2, Slot{0, 0, 0});
+    const std::size_t mask = table_.size() - 1;
+    for (const Slot& s : old)
+    {
+        if (s.stamp != stamp_) continue;
+        std::size_t i = hashOf(s.key) & mask;
+        while (table_[i].stamp == stamp_)
+            i = (i + 1) & mask;
+        table_[i] = s;
+    }
+}
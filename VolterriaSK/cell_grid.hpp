@@ -0,0 +1,140 @@
+//
+//  cell_grid.hpp
+//  Volterria
+//
+//  Created by Devin R Cohen on 10/18/26.
+//
+
+#pragma once
+
+// CellGrid: the Field's uniform spatial grid, with two storage backends.
+//
+// Dense keeps a FieldCell for every (cx, cy), so lookups are an index but
+// memory and clear() scale with world area. Sparse keeps only occupied
+// cells in an open-addressing hash table keyed by cell coordinates
+// (linear probing, load <= 1/2); clear() bumps a stamp instead of
+// touching the table, so its cost follows the cells that were in use.
+// Cells are pooled in both modes, so their index vectors keep capacity
+// from one rebuild to the next.
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+struct FieldCell
+{
+    std::vector<int> cell_creatures_indices;
+    std::vector<int> cell_grassPatches_indices;
+};
+
+// Per-cell aggregates gathered while the grid is rebuilt; the raw
+// material for level-of-detail heatmaps.
+struct CellStats
+{
+    uint32_t prey = 0;
+    uint32_t predators = 0;
+    float hunger_sum = 0.0f; // normalized hunger
+    float age_sum = 0.0f;    // normalized age
+};
+
+class CellGrid
+{
+public:
+    // Drop all cells and take on new dimensions and backend. Asked for the
+    // shape it already has, it just empties the cells and keeps them.
+    void configure(int num_cells_x, int num_cells_y, bool sparse);
+
+    // Empty every cell, keeping the grid's dimensions.
+    void clear();
+
+    // The cell at (cx, cy), created empty if the sparse table lacks it.
+    FieldCell& at(int cx, int cy) { return pool_[acquire(cx, cy)]; }
+    CellStats& statsAt(int cx, int cy) { return stats_[acquire(cx, cy)]; }
+
+    // nullptr if the cell holds nothing (sparse) or is out of range.
+    const FieldCell* find(int cx, int cy) const
+    {
+        const int i = lookup(cx, cy);
+        return i < 0 ? nullptr : &pool_[i];
+    }
+    const CellStats* findStats(int cx, int cy) const
+    {
+        const int i = lookup(cx, cy);
+        return i < 0 ? nullptr : &stats_[i];
+    }
+
+    // Visit fn(cx, cy, stats) for every cell that may be occupied: all of
+    // them when dense, only the ones in use when sparse.
+    template <typename Fn>
+    void forEachStats(Fn&& fn) const
+    {
+        if (!sparse_)
+        {
+            for (int cx = 0; cx < nx_; ++cx)
+                for (int cy = 0; cy < ny_; ++cy)
+                    fn(cx, cy, stats_[cx * ny_ + cy]);
+            return;
+        }
+        for (std::size_t i = 0; i < used_; ++i)
+            fn(pool_x_[i], pool_y_[i], stats_[i]);
+    }
+
+    // Same walk as forEachStats(), over the cells themselves.
+    template <typename Fn>
+    void forEachCell(Fn&& fn) const
+    {
+        if (!sparse_)
+        {
+            for (int cx = 0; cx < nx_; ++cx)
+                for (int cy = 0; cy < ny_; ++cy)
+                    fn(cx, cy, pool_[cx * ny_ + cy]);
+            return;
+        }
+        for (std::size_t i = 0; i < used_; ++i)
+            fn(pool_x_[i], pool_y_[i], pool_[i]);
+    }
+
+    bool sparse() const noexcept { return sparse_; }
+    int numCellsX() const noexcept { return nx_; }
+    int numCellsY() const noexcept { return ny_; }
+    std::size_t occupiedCells() const noexcept { return sparse_ ? used_ : pool_.size(); }
+
+private:
+    struct Slot
+    {
+        uint64_t key;
+        uint32_t cell;  // index into pool_
+        uint32_t stamp; // live only if == stamp_
+    };
+
+    static uint64_t keyOf(int cx, int cy) noexcept
+    {
+        return (static_cast<uint64_t>(static_cast<uint32_t>(cx)) << 32) | static_cast<uint32_t>(cy);
+    }
+    static std::size_t hashOf(uint64_t key) noexcept
+    {
+        key ^= key >> 33;
+        key *= 0xff51afd7ed558ccdULL;
+        key ^= key >> 33;
+        return static_cast<std::size_t>(key);
+    }
+
+    int lookup(int cx, int cy) const;
+    uint32_t acquire(int cx, int cy);
+    void grow();
+
+    bool sparse_ = false;
+    int nx_ = 0;
+    int ny_ = 0;
+
+    // Cells and their stats. Dense: indexed cx * ny + cy. Sparse: the
+    // first used_ entries are this rebuild's cells, in first-touch order.
+    std::vector<FieldCell> pool_;
+    std::vector<CellStats> stats_;
+    std::vector<int> pool_x_; // sparse: each cell's coordinates
+    std::vector<int> pool_y_;
+    std::size_t used_ = 0;
+
+    std::vector<Slot> table_; // sparse: power-of-two sized
+    uint32_t stamp_ = 1;
+};
@@ -13,6 +13,15 @@
 
 #include <cstddef>
 
+// Marks a loop as safe to vectorize (no loop-carried dependencies).
+#if defined(__clang__)
+#define VOLTERRIA_SIMD _Pragma("clang loop vectorize(enable) interleave(enable)")
+#elif defined(__GNUC__)
+#define VOLTERRIA_SIMD _Pragma("GCC ivdep")
+#else
+#define VOLTERRIA_SIMD
+#endif
+
 enum class Direction : int { Side = 0, Down = 1, Up = 2 };
 enum class Face : int { Left = -1, Right = 1 };
 
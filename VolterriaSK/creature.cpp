@@ -6,6 +6,7 @@
 //
 
 #include "creature.hpp"
+#include "species_policy.hpp"
 
 #include <algorithm>
 #include <cmath>
@@ -16,117 +17,108 @@
 //    return v.x * v.x + v.y * v.y;
 //}
 
-Creature::Creature(const uint32_t id,
-                   const Settings& settings,
-                   SpeciesRole       role,
-                   Sex               sex,
-                   const Vec2&       initial_position,
-                   const Vec2&       initial_velocity)
-    : id_(id),
-      species_(role),
-      sex_(sex),
-      position_(initial_position),
-      velocity_(initial_velocity),
-      rng_(std::random_device{}())
+template <typename Policy>
+void Creature::initialize(const Settings& settings, const CreatureRolls& rolls)
 {
-    if (species_ == SpeciesRole::Prey)
-    {
-        starve_rate_      = settings.prey_starve_rate;
-        libido_rate_      = settings.prey_libido_rate;
-        max_libido_       = settings.prey_libido_max;
-        libido_threshold_ = settings.prey_libido_threshold;
-        hunger_           = settings.prey_hunger_max;
-        max_hunger_       = settings.prey_hunger_max;
-    }
-    else // Predator
-    {
-        starve_rate_      = settings.pred_starve_rate;
-        libido_rate_      = settings.pred_libido_rate;
-        max_libido_       = settings.predator_libido_max;
-        libido_threshold_ = settings.pred_libido_threshold;
-        hunger_           = settings.predator_hunger_max; // start reasonably full
-        max_hunger_       = settings.predator_hunger_max;
-    }
+    starve_rate_      = Policy::starveRate(settings);
+    libido_rate_      = Policy::libidoRate(settings);
+    max_libido_       = Policy::libidoMax(settings);
+    libido_threshold_ = Policy::libidoThreshold(settings);
+    hunger_           = Policy::hungerMax(settings); // start reasonably full
+    max_hunger_       = Policy::hungerMax(settings);
     
-    std::uniform_real_distribution<float> libido_dist(0.0f, libido_threshold_);
-    libido_ = libido_dist(rng_);
+    libido_ = rolls.libido * libido_threshold_;
     
     // aging with variation
-    float base_max_age =
-        (species_ == SpeciesRole::Prey)
-        ? settings.prey_max_age :
-        settings.pred_max_age ;
+    const float base_max_age = Policy::maxAge(settings);
     
     float frac = settings.age_variation_fraction;
     
     if(frac > 0.0f)
     {
-        std::uniform_real_distribution<float> jitter(-frac, frac);
-        max_age_ = base_max_age * (1 + jitter(rng_));
+        const float jitter = -frac + 2.0f * frac * rolls.max_age;
+        max_age_ = base_max_age * (1 + jitter);
     }
+}
+
+Creature::Creature(const uint32_t id,
+                   const Settings& settings,
+                   SpeciesRole       role,
+                   Sex               sex,
+                   const Vec2&       initial_position,
+                   const Vec2&       initial_velocity,
+                   const CreatureRolls& rolls)
+    : id_(id),
+      species_(role),
+      sex_(sex),
+      position_(initial_position),
+      velocity_(initial_velocity)
+{
+    withSpecies(species_, [&](auto policy) { initialize<decltype(policy)>(settings, rolls); });
     
     age_ = 0.0; // life begins
     //std::cerr << (species_==SpeciesRole::Predator ? "Predator" : "Prey ") << "with mag age: " << max_age_ << std::endl;
 }
 
-void Creature::update(float dt, const Settings& settings, const SteeringIntent& intent)
+Creature::Creature(uint32_t id, const Creature& like, const Vec2& position)
+    : Creature(like)
+{
+    id_ = id;
+    position_ = position;
+}
+
+void Creature::update(float dt, const Settings& settings, const SteeringIntent& intent, const float* wander_accel)
+{
+    withSpecies(species_, [&](auto policy) { updateAs<decltype(policy)>(dt, settings, intent, wander_accel); });
+}
+
+template <typename Policy>
+void Creature::updateAs(float dt, const Settings& settings, const SteeringIntent& intent, const float* wander_accel)
 {
     if (!alive_) return;
 
-    // Update hunger / libido timers.
+    // Update hunger / libido timers. With event_timers the Field's timing
+    // wheel fires them instead (and kills of old age).
     age_ += dt;
-    if (age_ >= max_age_)
+    if (!settings.event_timers)
     {
-        alive_ = false;
-        return; // stop updating, Field will erase.
+        if (age_ >= max_age_)
+        {
+            kill(DeathCause::OldAge);
+            return; // stop updating, Field will erase.
+        }
+        
+        hunger_time_accumulator_ += dt;
+        accel_time_accumulator_  += dt;
     }
     
-    hunger_time_accumulator_ += dt;
-    accel_time_accumulator_  += dt;
-    
     // clear acceleration this tick
     acceleration_ = {0.f, 0.f};
     
-    const bool veryHungry = (species_ == SpeciesRole::Predator) ?
-        (hunger_ <= settings.pred_hunger_threshold) :
-        (hunger_ <= settings.prey_hunger_threshold);
+    const bool veryHungry = hunger_ <= Policy::hungerThreshold(settings);
     
-    const float libidoThresh = (species_ == SpeciesRole::Predator) ?
-        (libido_ <= settings.pred_libido_threshold) :
-        (libido_ <= settings.prey_libido_threshold);
+    const float libidoThresh = (libido_ <= Policy::libidoThreshold(settings));
     
     const bool wantsMate = libido_ >= libidoThresh;
 
     // hunt/mate priority
     if(veryHungry)
     {
-        if (species_ == SpeciesRole::Prey && intent.has_target) forage(dt, settings, intent);
-        else hunt(dt, settings, intent);
+        seekFood<Policy>(dt, settings, intent, wander_accel);
     } else if (wantsMate)
     {
-        seekMate(dt, settings, intent);
+        seekMateAs<Policy>(dt, settings, intent, wander_accel);
     } else {
-        wander(dt, settings);
+        wander(dt, settings, wander_accel);
     }
     
     // Starvation & libido growth.
-    if (hunger_time_accumulator_ >= settings.hunger_tick_seconds)
+    if (!settings.event_timers && hunger_time_accumulator_ >= settings.hunger_tick_seconds)
     {
         hunger_time_accumulator_ -= settings.hunger_tick_seconds;
-
-        // "Fullness" style hunger: predators lose fullness over time.
-        hunger_ -= starve_rate_ * settings.hunger_tick_seconds;
-        if (hunger_ < 0.0f)
-        {
-            hunger_ = 0.0f;
-            alive_ = false;
+        hungerTick(settings);
+        if (!alive_)
             return; // no need to update() anymore, Field will erase.
-        }
-        
-        // Libido grows for everyone up to their max.
-        libido_ += libido_rate_ * settings.hunger_tick_seconds;
-        if (libido_ > max_libido_)
-            libido_ = max_libido_;
     }
 
     //wander(dt, settings); // this is where the wandering happens
@@ -134,6 +126,23 @@ void Creature::update(float dt, const Settings& settings, const SteeringIntent&
     applyWorldBounds(settings); // fix OOB objects AFTER repositioning to prevent clipping
 }
 
+void Creature::hungerTick(const Settings& settings)
+{
+    // "Fullness" style hunger: predators lose fullness over time.
+    hunger_ -= starve_rate_ * settings.hunger_tick_seconds;
+    if (hunger_ < 0.0f)
+    {
+        hunger_ = 0.0f;
+        kill(DeathCause::Starved);
+        return;
+    }
+    
+    // Libido grows for everyone up to their max.
+    libido_ += libido_rate_ * settings.hunger_tick_seconds;
+    if (libido_ > max_libido_)
+        libido_ = max_libido_;
+}
+
 void Creature::integrate(float dt)
 {
     velocity_.x += acceleration_.x * dt;
@@ -142,18 +151,25 @@ void Creature::integrate(float dt)
     position_.y += velocity_.y * dt;
 }
 
-void Creature::wander(float dt, const Settings& settings)
+void Creature::wander(float dt, const Settings& settings, const float* wander_accel)
 {
-    if (accel_time_accumulator_ < settings.accel_tick)
-        return;
-
-    accel_time_accumulator_ -= settings.accel_tick;
+    if (settings.event_timers)
+    {
+        if (!timers_.accel_ready)
+            return;
+        timers_.accel_ready = false;
+    }
+    else
+    {
+        if (accel_time_accumulator_ < settings.accel_tick)
+            return;
+        accel_time_accumulator_ -= settings.accel_tick;
+    }
 
     // Simple random walk: pick a new acceleration vector with components
-    // in the range [-vmax, vmax].
-    std::uniform_real_distribution<float> accel_dist(-settings.vmax_default, settings.vmax_default);
-    acceleration_.x = accel_dist(rng_);
-    acceleration_.y = accel_dist(rng_);
+    // in the range [-vmax, vmax], pre-drawn by the Field.
+    acceleration_.x = wander_accel[0];
+    acceleration_.y = wander_accel[1];
 
     // Clamp velocity to avoid spiraling out of control.
     const float vlen2 = lengthSquared(velocity_);
@@ -255,115 +271,84 @@ void Creature::setHunger(float h)
 
 bool Creature::shouldHunt(const Settings& settings)
 {
-    float hunger_threshold = (species_ == SpeciesRole::Prey) ? settings.prey_hunger_threshold : settings.pred_hunger_threshold;
-    return hunger_ <= hunger_threshold;
+    return withSpecies(species_, [&](auto policy) { return hunger_ <= decltype(policy)::hungerThreshold(settings); });
 }
 
 bool Creature::shouldSeekMate(const Settings& settings)
 {
-    float libido_threshold = (species_ == SpeciesRole::Prey) ? settings.prey_libido_threshold : settings.pred_libido_threshold;
-    return libido_ >= libido_threshold;
-}
-
-
-// TO-DO: merge hunt and forage as seekFood, do species checks inside, and generalize
-// Get rid of species checks in update() and simply call seekFood()
-void Creature::hunt(float dt, const Settings& settings, const SteeringIntent&  intent)
-{
-    // no one to hunt, just dilly dally for now
-    // may remove, hunt should not receive a Prey any longer, but keep as a guard
-    if (species_ != SpeciesRole::Predator)
-    {
-        wander(dt, settings);
-        return;
-    }
-    
-    if(!intent.has_target)
-    {
-        wander(dt, settings);
-        return;
-    }
-    
-    // hunting urgency - map 0 to 1
-    float urgency = 0.f;
-    if (species_ == SpeciesRole::Predator)
-    {
-        const float hungry = settings.pred_hunger_threshold;
-        urgency = (hungry - hunger_) / hungry;
-        urgency = std::clamp(urgency, 0.f, 1.f);
-    }
-    
-    //const float baseSpeed = 100.f; // verify if check for species
-    const float desiredSpeed = settings.predator_hunt_speed_min + (settings.predator_hunt_speed_max - settings.predator_hunt_speed_min) * urgency;
-    
-    const float maxAccel = settings.predator_hunt_max_accel; // make const pred_max_accel in settings
-    Vec2 dir = normalize(intent.desired_dir);
-    applySeekSteering(dir, desiredSpeed, maxAccel);
+    return withSpecies(species_, [&](auto policy) { return libido_ >= decltype(policy)::libidoThreshold(settings); });
 }
 
-void Creature::forage(float dt, const Settings& settings, const SteeringIntent& intent)
+// Hunting and foraging are the same steering with each species' own food
+// speeds; only what the intent points at differs.
+template <typename Policy>
+void Creature::seekFood(float dt, const Settings& settings, const SteeringIntent& intent, const float* wander_accel)
 {
-    if (species_ != SpeciesRole::Prey)
-    {
-        wander(dt, settings);
-        return;
-    }
-    
+    // nothing to eat in sight, just dilly dally for now
     if(!intent.has_target)
     {
-        wander(dt, settings);
+        wander(dt, settings, wander_accel);
         return;
     }
     
     // hunting urgency - map 0 to 1
-    float urgency = 0.f;
-    if (species_ == SpeciesRole::Prey)
-    {
-        const float hungry = settings.prey_hunger_threshold;
-        urgency = (hungry - hunger_) / hungry;
-        urgency = std::clamp(urgency, 0.f, 1.f);
-    }
+    const float hungry = Policy::hungerThreshold(settings);
+    float urgency = (hungry - hunger_) / hungry;
+    urgency = std::clamp(urgency, 0.f, 1.f);
     
-    //const float baseSpeed = 100.f; // verify if check for species
-    const float desiredSpeed = settings.prey_forage_speed_min + (settings.prey_forage_speed_max - settings.prey_forage_speed_min) * urgency;
+    const float speedMin = Policy::foodSpeedMin(settings);
+    const float desiredSpeed = speedMin + (Policy::foodSpeedMax(settings) - speedMin) * urgency;
     
-    const float maxAccel = settings.prey_forage_max_accel;
+    const float maxAccel = Policy::foodMaxAccel(settings);
     Vec2 dir = normalize(intent.desired_dir);
     applySeekSteering(dir, desiredSpeed, maxAccel);
 }
 
-void Creature::seekMate(float dt, const Settings& settings, const SteeringIntent& intent)
+template <typename Policy>
+void Creature::seekMateAs(float dt, const Settings& settings, const SteeringIntent& intent, const float* wander_accel)
 {
     // no mate found, dilly dally
     if(!intent.has_target)
     {
-        wander(dt, settings);
+        wander(dt, settings, wander_accel);
         return;
     }
     
     // Libido urgency
-    const float libidoThresh = (species_ == SpeciesRole::Prey) ? settings.prey_libido_threshold : settings.pred_libido_threshold;
+    const float libidoThresh = Policy::libidoThreshold(settings);
     float drive = (libido_ - libidoThresh) / std::max(1e-6f, (1.0f - libidoThresh));
     drive = std::clamp(drive, 0.f, 1.f);
     
     // mate seeking is less "full speed chase" than hunting
-    const float speedMax = (species_ == SpeciesRole::Prey)
-        ? settings.prey_mate_speed_max
-        : settings.predator_mate_speed_max;
-
-    const float speedMin = (species_ == SpeciesRole::Prey)
-        ? settings.prey_mate_speed_min
-        : settings.predator_mate_speed_min;
-
-    const float accelMax = (species_ == SpeciesRole::Prey)
-        ? settings.prey_mate_max_accel
-        : settings.predator_mate_max_accel;
+    const float speedMax = Policy::mateSpeedMax(settings);
+    const float speedMin = Policy::mateSpeedMin(settings);
 
     // drive is 0..1 already
     const float desiredSpeed = speedMin + (speedMax - speedMin) * drive; // CHANGE
-    const float maxAccel     = accelMax;
+    const float maxAccel     = Policy::mateMaxAccel(settings);
     
     Vec2 dir = normalize(intent.desired_dir);
     applySeekSteering(dir, desiredSpeed, maxAccel);
 }
 
+void Creature::hunt(float dt, const Settings& settings, const SteeringIntent& intent, const float* wander_accel)
+{
+    // hunt should not receive a Prey any longer, but keep as a guard
+    if (species_ != SpeciesRole::Predator)
+        wander(dt, settings, wander_accel);
+    else
+        seekFood<SpeciesPolicy<SpeciesRole::Predator>>(dt, settings, intent, wander_accel);
+}
+
+void Creature::forage(float dt, const Settings& settings, const SteeringIntent& intent, const float* wander_accel)
+{
+    if (species_ != SpeciesRole::Prey)
+        wander(dt, settings, wander_accel);
+    else
+        seekFood<SpeciesPolicy<SpeciesRole::Prey>>(dt, settings, intent, wander_accel);
+}
+
+void Creature::seekMate(float dt, const Settings& settings, const SteeringIntent& intent, const float* wander_accel)
+{
+    withSpecies(species_, [&](auto policy) { seekMateAs<decltype(policy)>(dt, settings, intent, wander_accel); });
+}
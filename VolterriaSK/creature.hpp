@@ -13,12 +13,14 @@
 // and internal state like hunger and libido.
 
 #include <iostream>
-#include <random>
+#include <cmath>
+#include <cstdint>
 #include "constants.hpp"
 #include "settings.hpp"
 
 enum class SpeciesRole : int { Prey = 0, Predator = 1 };
 enum class Sex : int { Male = 0, Female = 1 };
+enum class DeathCause : int { None = 0, Eaten = 1, Starved = 2, OldAge = 3 };
 // declaring as a struct instead of class makes all members public by default
 // equivalent to class Vec2{ public: ... };
 struct Vec2
@@ -95,9 +97,36 @@ static inline Vec2 clampMagnitude(const Vec2& v, float maxMag)
     return { v.x * (maxMag/m), v.y * (maxMag/m) };
 }
 
+// Uniform [0, 1) draws a new Creature needs, handed over by the Field's
+// random streams so creatures don't each own a generator.
+struct CreatureRolls {
+    float libido  = 0.0f; // starting libido as a fraction of the threshold
+    float max_age = 0.5f; // where max age lands in the +/- variation band
+};
+
+enum class TargetKind : uint8_t { None, Creature, Grass, GrassCell }; // GrassCell: a GrassRaster cell index
+
+// A ghost is a read-only copy of a creature owned by a neighboring
+// subdomain (see domain.hpp). It is seen and can be eaten or mated with,
+// but never updated here. Of the two domains that see a cross-boundary
+// pair, only the one holding a Resolve ghost decides what happens.
+enum class GhostKind : uint8_t { None, Resolve, Observe };
+
+// Next due tick of each of a creature's timers on the Field's timing
+// wheel. Only used with Settings::event_timers, in place of the per-step
+// accumulators; kept on the creature so a keyframe carries them.
+struct CreatureTimers {
+    uint32_t hunger_due = 0;
+    uint32_t accel_due  = 0;
+    uint32_t death_due  = 0;
+    bool accel_ready    = false; // a wander re-roll is owed
+};
+
 struct SteeringIntent {
     Vec2 desired_dir{0.f, 0.f};
     bool has_target = false;
+    TargetKind target_kind = TargetKind::None;
+    uint32_t target_id = 0; // packed creature handle, or grass patch index
 };
 
 class Creature
@@ -108,11 +137,18 @@ public:
              SpeciesRole       role,
              Sex               sex,
              const Vec2&       initial_position,
-             const Vec2&       initial_velocity);
+             const Vec2&       initial_velocity,
+             const CreatureRolls& rolls);
+    
+    // A copy of `like` (age, hunger, libido and all) under a new id and at
+    // a new position.
+    Creature(uint32_t id, const Creature& like, const Vec2& position);
 
-    // Per-frame update entry point used by Field.
-    void update(float dt, const Settings& settings, const SteeringIntent& intent);
+    // Per-frame update entry point used by Field. wander_accel points at this
+    // creature's two pre-drawn acceleration components in [-vmax, vmax].
+    void update(float dt, const Settings& settings, const SteeringIntent& intent, const float* wander_accel);
     void setHunger(float);
+    void hungerTick(const Settings&); // starve and grow libido by one hunger tick; may kill
     void setCellLocation(float, float);
 
     // Simple getters used by the Field / snapshot layer.
@@ -121,6 +157,7 @@ public:
     const Vec2& position()    const noexcept { return position_; }
     const Vec2& velocity()    const noexcept { return velocity_; }
     bool        isAlive()     const noexcept { return alive_;   }
+    DeathCause  deathCause()  const noexcept { return death_cause_; }
     bool        shouldHunt(const Settings&);
     bool        shouldSeekMate(const Settings&);
     float       hunger() const noexcept { return hunger_; }
@@ -129,25 +166,41 @@ public:
     float       normalizedAge() const noexcept { return age_/max_age_; }
     float       libido()      const noexcept { return libido_;  }
     float       libidoThreshold() const noexcept { return libido_threshold_; }
+    float       maxAge()      const noexcept { return max_age_; }
+    CreatureTimers&       timers()       noexcept { return timers_; }
+    const CreatureTimers& timers() const noexcept { return timers_; }
     uint32_t id() const noexcept { return id_; }
+    GhostKind   ghostKind()   const noexcept { return ghost_; }
+    bool        isGhost()     const noexcept { return ghost_ != GhostKind::None; }
+    void        setGhostKind(GhostKind kind) noexcept { ghost_ = kind; }
 //    int cx() const noexcept { return cell_x_; }
 //    int cy() const noexcept { return cell_y_; }
 
-    void kill() noexcept { alive_ = false; }
+    void kill(DeathCause cause = DeathCause::Eaten) noexcept { alive_ = false; death_cause_ = cause; }
+    void confineTo(const Settings& settings) { applyWorldBounds(settings); } // after the world shrinks
 
     // Hooks called by the Field when this creature eats prey or mates.
     void onEat(const Settings& settings);
     void onMate(const Settings& settings);
     void add_hunger(float amount, float max_hunger);
-    void hunt(float, const Settings&, const SteeringIntent&);
-    void forage(float,const Settings&, const SteeringIntent&);
-    void seekMate(float, const Settings&, const SteeringIntent&);
+    void hunt(float, const Settings&, const SteeringIntent&, const float*);
+    void forage(float,const Settings&, const SteeringIntent&, const float*);
+    void seekMate(float, const Settings&, const SteeringIntent&, const float*);
 
 private:
+    friend class CreatureKernel; // batched update path, see creature_kernel.hpp
+    
     void integrate(float dt);
-    void wander(float dt, const Settings& settings);
+    void wander(float dt, const Settings& settings, const float* wander_accel);
     void applyWorldBounds(const Settings& settings);
     void applySeekSteering(const Vec2&, float, float);
+
+    // Species-specialized bodies, Policy being a SpeciesPolicy<R> (see
+    // species_policy.hpp); the public entry points pick one per creature.
+    template <typename Policy> void initialize(const Settings&, const CreatureRolls&);
+    template <typename Policy> void updateAs(float, const Settings&, const SteeringIntent&, const float*);
+    template <typename Policy> void seekFood(float, const Settings&, const SteeringIntent&, const float*);
+    template <typename Policy> void seekMateAs(float, const Settings&, const SteeringIntent&, const float*);
     
     uint32_t id_;
     
@@ -159,6 +212,7 @@ private:
     Vec2 acceleration_;
 
     bool  alive_            = true;
+    DeathCause death_cause_ = DeathCause::None;
     float hunger_           = 0.0f;  // "fullness" style hunger: 0 = starving
     float max_hunger_       = 0.0f;
     float libido_           = 0.0f;
@@ -169,6 +223,8 @@ private:
 
     float accel_time_accumulator_  = 0.0f;
     float hunger_time_accumulator_ = 0.0f;
+    CreatureTimers timers_; // event_timers only
+    GhostKind ghost_ = GhostKind::None;
     
     // what cell is it in?
 //    int cell_x_, cell_y_;
@@ -179,8 +235,6 @@ private:
     
 //    bool should_hunt_ = false;
 //    bool should_seek_mate_ = false;
-
-    std::mt19937 rng_;
 };
 
 
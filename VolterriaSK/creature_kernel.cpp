@@ -0,0 +1,279 @@
+//
+//  creature_kernel.cpp
+//  Volterria
+//
+//  Created by Devin R Cohen on 10/18/26.
+//
+
+#include "creature_kernel.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+SpeciesParamTable SpeciesParamTable::fromSettings(const Settings& settings)
+{
+    SpeciesParamTable t;
+    t.species[static_cast<int>(SpeciesRole::Prey)]     = speciesParams<SpeciesRole::Prey>(settings);
+    t.species[static_cast<int>(SpeciesRole::Predator)] = speciesParams<SpeciesRole::Predator>(settings);
+    return t;
+}
+
+namespace
+{
+    constexpr std::size_t kBlock = CreatureKernel::kBlock;
+
+    // Per-creature parameters, gathered from the table by species.
+    struct MixedParams
+    {
+        const SpeciesParamTable& table;
+        alignas(64) float hunger_thr[kBlock], libido_thr[kBlock];
+        alignas(64) float food_min[kBlock], food_max[kBlock], food_accel[kBlock];
+        alignas(64) float mate_min[kBlock], mate_max[kBlock], mate_accel[kBlock];
+        alignas(64) float starve[kBlock], libido_rate[kBlock], libido_max[kBlock];
+
+        explicit MixedParams(const SpeciesParamTable& t) : table(t) {}
+
+        void gather(std::size_t i, SpeciesRole role) noexcept
+        {
+            const SpeciesParams& sp = table[role];
+            hunger_thr[i]  = sp.hunger_threshold;
+            libido_thr[i]  = sp.libido_threshold;
+            food_min[i]    = sp.food_speed_min;
+            food_max[i]    = sp.food_speed_max;
+            food_accel[i]  = sp.food_max_accel;
+            mate_min[i]    = sp.mate_speed_min;
+            mate_max[i]    = sp.mate_speed_max;
+            mate_accel[i]  = sp.mate_max_accel;
+            starve[i]      = sp.starve_rate;
+            libido_rate[i] = sp.libido_rate;
+            libido_max[i]  = sp.libido_max;
+        }
+
+        float hungerThreshold(std::size_t i) const noexcept { return hunger_thr[i]; }
+        float libidoThreshold(std::size_t i) const noexcept { return libido_thr[i]; }
+        float foodSpeedMin(std::size_t i)    const noexcept { return food_min[i]; }
+        float foodSpeedMax(std::size_t i)    const noexcept { return food_max[i]; }
+        float foodMaxAccel(std::size_t i)    const noexcept { return food_accel[i]; }
+        float mateSpeedMin(std::size_t i)    const noexcept { return mate_min[i]; }
+        float mateSpeedMax(std::size_t i)    const noexcept { return mate_max[i]; }
+        float mateMaxAccel(std::size_t i)    const noexcept { return mate_accel[i]; }
+        float starveRate(std::size_t i)      const noexcept { return starve[i]; }
+        float libidoRate(std::size_t i)      const noexcept { return libido_rate[i]; }
+        float libidoMax(std::size_t i)       const noexcept { return libido_max[i]; }
+    };
+
+    // One species for the whole block: nothing to gather, and every
+    // parameter is the same scalar in each loop.
+    struct UniformParams
+    {
+        SpeciesParams sp;
+
+        void gather(std::size_t, SpeciesRole) noexcept {}
+
+        float hungerThreshold(std::size_t) const noexcept { return sp.hunger_threshold; }
+        float libidoThreshold(std::size_t) const noexcept { return sp.libido_threshold; }
+        float foodSpeedMin(std::size_t)    const noexcept { return sp.food_speed_min; }
+        float foodSpeedMax(std::size_t)    const noexcept { return sp.food_speed_max; }
+        float foodMaxAccel(std::size_t)    const noexcept { return sp.food_max_accel; }
+        float mateSpeedMin(std::size_t)    const noexcept { return sp.mate_speed_min; }
+        float mateSpeedMax(std::size_t)    const noexcept { return sp.mate_speed_max; }
+        float mateMaxAccel(std::size_t)    const noexcept { return sp.mate_max_accel; }
+        float starveRate(std::size_t)      const noexcept { return sp.starve_rate; }
+        float libidoRate(std::size_t)      const noexcept { return sp.libido_rate; }
+        float libidoMax(std::size_t)       const noexcept { return sp.libido_max; }
+    };
+}
+
+void CreatureKernel::update(Creature* creatures, const SteeringIntent* intents, const float* wander_accel,
+                            std::size_t count, float dt, const Settings& settings)
+{
+    const SpeciesParamTable table = SpeciesParamTable::fromSettings(settings);
+    MixedParams mixed(table);
+    UniformParams uniform[2] = { {table[SpeciesRole::Prey]}, {table[SpeciesRole::Predator]} };
+    for (std::size_t begin = 0; begin < count; begin += kBlock)
+    {
+        const std::size_t n = std::min(kBlock, count - begin);
+        Creature* block = creatures + begin;
+        const SpeciesRole role = block[0].species_;
+        bool single = true;
+        for (std::size_t i = 1; i < n && single; ++i)
+            single = block[i].species_ == role;
+
+        if (single)
+            updateBlock(block, intents + begin, wander_accel + 2 * begin, n, dt, settings, uniform[static_cast<int>(role)]);
+        else
+            updateBlock(block, intents + begin, wander_accel + 2 * begin, n, dt, settings, mixed);
+    }
+}
+
+template <typename Params>
+void CreatureKernel::updateBlock(Creature* creatures, const SteeringIntent* intents, const float* wander_accel,
+                                 std::size_t n, float dt, const Settings& settings, Params& params)
+{
+    alignas(64) float px[kBlock], py[kBlock], vx[kBlock], vy[kBlock], ax[kBlock], ay[kBlock];
+    alignas(64) float dir_x[kBlock], dir_y[kBlock];
+    alignas(64) float hunger[kBlock], libido[kBlock], hunger_acc[kBlock];
+    alignas(64) int32_t live[kBlock], has_target[kBlock], wander[kBlock], moving[kBlock];
+
+    // Gather. Aging happens here because old-age death ends the update
+    // before anything else is touched.
+    const bool event_timers = settings.event_timers;
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        Creature& c = creatures[i];
+        live[i] = c.alive_ && !c.isGhost(); // ghosts are updated by their owner
+        if (live[i])
+        {
+            c.age_ += dt;
+            // With event_timers the timing wheel handles old age and the
+            // tick timers.
+            if (!event_timers)
+            {
+                if (c.age_ >= c.max_age_)
+                {
+                    c.kill(DeathCause::OldAge);
+                    live[i] = 0;
+                }
+                else
+                {
+                    c.hunger_time_accumulator_ += dt;
+                    c.accel_time_accumulator_  += dt;
+                }
+            }
+        }
+
+        params.gather(i, c.species_);
+        px[i] = c.position_.x;  py[i] = c.position_.y;
+        vx[i] = c.velocity_.x;  vy[i] = c.velocity_.y;
+        dir_x[i] = intents[i].desired_dir.x;
+        dir_y[i] = intents[i].desired_dir.y;
+        has_target[i] = intents[i].has_target;
+        hunger[i]     = c.hunger_;
+        libido[i]     = c.libido_;
+        hunger_acc[i] = c.hunger_time_accumulator_;
+    }
+
+    // Behavior selection and seek steering as masks.
+    VOLTERRIA_SIMD
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        const float hunger_thr = params.hungerThreshold(i);
+        const float libido_thr = params.libidoThreshold(i);
+        const bool very_hungry = hunger[i] <= hunger_thr;
+        // Creature::update compares libido against the 0/1 result of
+        // (libido <= threshold); kept as-is so both paths agree.
+        const float libido_cmp = (libido[i] <= libido_thr) ? 1.0f : 0.0f;
+        const bool wants_mate = libido[i] >= libido_cmp;
+
+        const bool seek_food = live[i] && has_target[i] && very_hungry;
+        const bool seek_mate = live[i] && has_target[i] && !very_hungry && wants_mate;
+
+        const float urgency = std::clamp((hunger_thr - hunger[i]) / hunger_thr, 0.f, 1.f);
+        const float drive = std::clamp((libido[i] - libido_thr) / std::max(1e-6f, (1.0f - libido_thr)), 0.f, 1.f);
+        const float food_min = params.foodSpeedMin(i);
+        const float mate_min = params.mateSpeedMin(i);
+        const float speed = seek_food
+            ? food_min + (params.foodSpeedMax(i) - food_min) * urgency
+            : mate_min + (params.mateSpeedMax(i) - mate_min) * drive;
+        const float max_accel = seek_food ? params.foodMaxAccel(i) : params.mateMaxAccel(i);
+
+        const float m = std::sqrt(dir_x[i] * dir_x[i] + dir_y[i] * dir_y[i]);
+        const float nx = (m <= 1e-6f) ? 0.f : dir_x[i] / m;
+        const float ny = (m <= 1e-6f) ? 0.f : dir_y[i] / m;
+
+        const float sx = nx * speed - vx[i];
+        const float sy = ny * speed - vy[i];
+        const float s2 = sx * sx + sy * sy;
+        const float k  = max_accel / std::sqrt(s2);
+        const bool  under = s2 <= max_accel * max_accel;
+
+        const bool seeking = seek_food || seek_mate;
+        ax[i] = seeking ? (under ? sx : sx * k) : 0.f;
+        ay[i] = seeking ? (under ? sy : sy * k) : 0.f;
+        wander[i] = live[i] && !seeking;
+    }
+
+    // Only creatures whose re-roll timer is due take their pre-drawn values.
+    const float vmax  = settings.vmax_default;
+    const float vmax2 = vmax * vmax;
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        if (!wander[i]) continue;
+        Creature& c = creatures[i];
+        if (event_timers)
+        {
+            if (!c.timers_.accel_ready) continue;
+            c.timers_.accel_ready = false;
+        }
+        else
+        {
+            if (c.accel_time_accumulator_ < settings.accel_tick) continue;
+            c.accel_time_accumulator_ -= settings.accel_tick;
+        }
+
+        ax[i] = wander_accel[2 * i];
+        ay[i] = wander_accel[2 * i + 1];
+
+        const float vlen2 = vx[i] * vx[i] + vy[i] * vy[i];
+        if (vlen2 > vmax2 && vlen2 > 0.0f)
+        {
+            const float scale = vmax / std::sqrt(vlen2);
+            vx[i] *= scale;
+            vy[i] *= scale;
+        }
+    }
+
+    // Starvation and libido growth on the hunger tick (already applied by
+    // the timing wheel with event_timers).
+    const float tick = settings.hunger_tick_seconds;
+    VOLTERRIA_SIMD
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        const bool due = live[i] && !event_timers && hunger_acc[i] >= tick;
+        const float h = hunger[i] - params.starveRate(i) * tick;
+        const bool starved = due && h < 0.0f;
+        hunger_acc[i] = due ? hunger_acc[i] - tick : hunger_acc[i];
+        hunger[i] = due ? (starved ? 0.0f : h) : hunger[i];
+        libido[i] = (due && !starved) ? std::min(libido[i] + params.libidoRate(i) * tick, params.libidoMax(i)) : libido[i];
+        moving[i] = live[i] && !starved;
+    }
+
+    // Integrate and bounce off the world bounds.
+    const float x_min = settings.x_min, x_max = settings.x_max;
+    const float y_min = settings.y_min, y_max = settings.y_max;
+    VOLTERRIA_SIMD
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        const float nvx = vx[i] + ax[i] * dt;
+        const float nvy = vy[i] + ay[i] * dt;
+        const float npx = px[i] + nvx * dt;
+        const float npy = py[i] + nvy * dt;
+
+        const bool bounce_x = npx < x_min || npx > x_max;
+        const bool bounce_y = npy < y_min || npy > y_max;
+        const float cpx = npx < x_min ? x_min : (npx > x_max ? x_max : npx);
+        const float cpy = npy < y_min ? y_min : (npy > y_max ? y_max : npy);
+
+        px[i] = moving[i] ? cpx : px[i];
+        py[i] = moving[i] ? cpy : py[i];
+        vx[i] = moving[i] ? (bounce_x ? -nvx : nvx) : vx[i];
+        vy[i] = moving[i] ? (bounce_y ? -nvy : nvy) : vy[i];
+        ax[i] = (moving[i] && bounce_x) ? -ax[i] : ax[i];
+        ay[i] = (moving[i] && bounce_y) ? -ay[i] : ay[i];
+    }
+
+    // Scatter.
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        if (!live[i]) continue;
+        Creature& c = creatures[i];
+        c.position_     = {px[i], py[i]};
+        c.velocity_     = {vx[i], vy[i]};
+        c.acceleration_ = {ax[i], ay[i]};
+        c.hunger_       = hunger[i];
+        c.libido_       = libido[i];
+        c.hunger_time_accumulator_ = hunger_acc[i];
+        if (!moving[i])
+            c.kill(DeathCause::Starved);
+    }
+}
@@ -0,0 +1,56 @@
+//
+//  creature_kernel.hpp
+//  Volterria
+//
+//  Created by Devin R Cohen on 10/18/26.
+//
+
+#pragma once
+
+// Batched creature update.
+// Does the same work as calling Creature::update on every creature, but
+// block by block: state is gathered into small structure-of-arrays
+// buffers, behavior selection (forage/hunt, seek mate, wander) is done
+// with masks instead of per-creature branches, thresholds come from a
+// per-species table built once per call, and steering, integration and
+// world bounds run as straight-line loops the compiler can vectorize.
+// A block of a single species (the usual case, with creatures stored by
+// species; see Settings::segregate_species) skips the per-creature
+// gather of thresholds and uses that species' values throughout.
+
+#include <cstddef>
+
+#include "creature.hpp"
+#include "settings.hpp"
+#include "species_policy.hpp"
+
+// Both species' parameters, indexed by SpeciesRole, for blocks that mix
+// them.
+struct SpeciesParamTable
+{
+    SpeciesParams species[2]; // [SpeciesRole::Prey], [SpeciesRole::Predator]
+
+    static SpeciesParamTable fromSettings(const Settings& settings);
+    const SpeciesParams& operator[](SpeciesRole role) const noexcept { return species[static_cast<int>(role)]; }
+};
+
+class CreatureKernel
+{
+public:
+    // Creatures processed per gather/scatter block.
+    static constexpr std::size_t kBlock = 64;
+
+    // Update creatures[0, count). intents[i] and wander_accel[2i, 2i+2)
+    // belong to creatures[i].
+    static void update(Creature* creatures, const SteeringIntent* intents, const float* wander_accel,
+                       std::size_t count, float dt, const Settings& settings);
+
+private:
+    // Where a block's per-creature thresholds and speeds come from: a
+    // gathered array per field when the block mixes species, or one
+    // species' values for all of it (see MixedParams / UniformParams in
+    // creature_kernel.cpp).
+    template <typename Params>
+    static void updateBlock(Creature* creatures, const SteeringIntent* intents, const float* wander_accel,
+                            std::size_t count, float dt, const Settings& settings, Params& params);
+};
@@ -0,0 +1,277 @@
+//
+//  domain.cpp
+//  Volterria
+//
+//  Created by Devin R Cohen on 10/18/26.
+//
+
+#include "domain.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+#include <type_traits>
+
+static_assert(std::is_trivially_copyable_v<Creature>, "creatures cross subdomains as raw bytes");
+
+namespace
+{
+    using Message = HaloTransport::Message;
+
+    // Wire records, back to back in each message:
+    //   halo:     owner's id, creature
+    //   effect:   owner's id, GhostEffectType
+    //   migrant:  creature
+    constexpr std::size_t kHaloRecord    = sizeof(uint32_t) + sizeof(Creature);
+    constexpr std::size_t kEffectRecord  = sizeof(uint32_t) + sizeof(uint8_t);
+    constexpr std::size_t kMigrantRecord = sizeof(Creature);
+
+    template <typename T>
+    void append(Message& m, const T& value)
+    {
+        const std::byte* p = reinterpret_cast<const std::byte*>(&value);
+        m.insert(m.end(), p, p + sizeof(T));
+    }
+
+    template <typename T>
+    T readAt(const Message& m, std::size_t offset)
+    {
+        T value;
+        std::memcpy(&value, m.data() + offset, sizeof(T));
+        return value;
+    }
+
+    // Creature has no default constructor, so unpack into raw storage.
+    struct CreatureBytes
+    {
+        alignas(Creature) std::byte bytes[sizeof(Creature)];
+        const Creature& get() const noexcept { return *reinterpret_cast<const Creature*>(bytes); }
+    };
+
+    CreatureBytes readCreature(const Message& m, std::size_t offset)
+    {
+        CreatureBytes c;
+        std::memcpy(c.bytes, m.data() + offset, sizeof(Creature));
+        return c;
+    }
+
+    Settings subdomainSettings(Settings s)
+    {
+        // Every node spawns the same initial population and keeps its own
+        // share, so they must all draw the same one.
+        if (s.rng_seed == 0)
+        {
+            std::cerr << "domain decomposition needs a fixed rng_seed; using 1\n";
+            s.rng_seed = 1;
+        }
+        s.sparse_grid = true; // the grid spans the world, the creatures one tile of it
+        return s;
+    }
+}
+
+// MARK: - Layout
+
+float DomainRect::distanceSquared(const Vec2& p) const noexcept
+{
+    const float dx = std::max({x0 - p.x, 0.0f, p.x - x1});
+    const float dy = std::max({y0 - p.y, 0.0f, p.y - y1});
+    return dx * dx + dy * dy;
+}
+
+DomainLayout::DomainLayout(const Settings& settings, int tiles_x, int tiles_y)
+    : x_min_(settings.x_min), y_min_(settings.y_min),
+      tile_w_((settings.x_max - settings.x_min) / std::max(tiles_x, 1)),
+      tile_h_((settings.y_max - settings.y_min) / std::max(tiles_y, 1)),
+      tiles_x_(std::max(tiles_x, 1)), tiles_y_(std::max(tiles_y, 1))
+{
+}
+
+DomainRect DomainLayout::rect(int rank) const noexcept
+{
+    const int tx = rank % tiles_x_;
+    const int ty = rank / tiles_x_;
+    return { x_min_ + tx * tile_w_, y_min_ + ty * tile_h_,
+             x_min_ + (tx + 1) * tile_w_, y_min_ + (ty + 1) * tile_h_ };
+}
+
+int DomainLayout::ownerOf(const Vec2& p) const noexcept
+{
+    const int tx = std::clamp(static_cast<int>(std::floor((p.x - x_min_) / tile_w_)), 0, tiles_x_ - 1);
+    const int ty = std::clamp(static_cast<int>(std::floor((p.y - y_min_) / tile_h_)), 0, tiles_y_ - 1);
+    return ty * tiles_x_ + tx;
+}
+
+std::vector<int> DomainLayout::neighborsOf(int rank, float halo) const
+{
+    const DomainRect a = rect(rank);
+    std::vector<int> out;
+    for (int r = 0; r < size(); ++r)
+    {
+        if (r == rank) continue;
+        const DomainRect b = rect(r);
+        const float gx = std::max({a.x0 - b.x1, 0.0f, b.x0 - a.x1});
+        const float gy = std::max({a.y0 - b.y1, 0.0f, b.y0 - a.y1});
+        if (gx * gx + gy * gy <= halo * halo)
+            out.push_back(r);
+    }
+    return out;
+}
+
+// MARK: - Node
+
+DomainNode::DomainNode(const Settings& settings, int tiles_x, int tiles_y, std::unique_ptr<HaloTransport> transport)
+    : field_(subdomainSettings(settings)),
+      layout_(settings, tiles_x, tiles_y),
+      transport_(std::move(transport)),
+      rank_(transport_->rank()),
+      rect_(layout_.rect(rank_))
+{
+    if (transport_->size() != layout_.size())
+        std::cerr << "transport has " << transport_->size() << " ranks for "
+                  << layout_.size() << " subdomains\n";
+
+    // Anything a creature here could see or touch must be here as a ghost.
+    halo_ = std::max({settings.predator_vision_radius, settings.prey_vision_radius, settings.interaction_radius});
+    neighbors_ = layout_.neighborsOf(rank_, halo_);
+    for (int r : neighbors_)
+        neighbor_rects_.push_back(layout_.rect(r));
+    outgoing_.resize(neighbors_.size());
+    incoming_.resize(neighbors_.size());
+}
+
+void DomainNode::reset()
+{
+    field_.ResetFromSettings();
+
+    leaving_.clear();
+    for (const Creature& c : field_.creatures())
+    {
+        if (layout_.ownerOf(c.position()) != rank_)
+            leaving_.push_back(SlotHandle::fromPacked(c.id()));
+    }
+    for (SlotHandle h : leaving_)
+        field_.releaseCreature(h);
+    field_.retainGrass([&](const GrassPatch& g) { return layout_.ownerOf(g.center) == rank_; });
+
+    ghost_origin_.clear();
+    ghost_count_ = 0;
+    migrant_count_ = 0;
+}
+
+bool DomainNode::step(float dt)
+{
+    if (!exchangeHalos()) return false;
+    field_.step(dt);
+    if (!exchangeEffects()) return false;
+    return migrate();
+}
+
+bool DomainNode::exchangeHalos()
+{
+    for (Message& m : outgoing_)
+        m.clear();
+
+    const float halo2 = halo_ * halo_;
+    for (const Creature& c : field_.creatures())
+    {
+        if (!c.isAlive()) continue;
+        for (std::size_t k = 0; k < neighbors_.size(); ++k)
+        {
+            if (neighbor_rects_[k].distanceSquared(c.position()) > halo2) continue;
+            append(outgoing_[k], c.id());
+            append(outgoing_[k], c);
+        }
+    }
+
+    if (!transport_->exchange(neighbors_, outgoing_, incoming_)) return false;
+
+    ghost_count_ = 0;
+    for (std::size_t k = 0; k < neighbors_.size(); ++k)
+    {
+        // The lower rank of a pair resolves what happens across its border.
+        const GhostKind kind = neighbors_[k] > rank_ ? GhostKind::Resolve : GhostKind::Observe;
+        const Message& m = incoming_[k];
+        for (std::size_t off = 0; off + kHaloRecord <= m.size(); off += kHaloRecord)
+        {
+            const uint32_t owner_id = readAt<uint32_t>(m, off);
+            const SlotHandle h = field_.adoptCreature(readCreature(m, off + sizeof(uint32_t)).get(), kind);
+            if (h.index >= ghost_origin_.size())
+                ghost_origin_.resize(h.index + 1);
+            ghost_origin_[h.index] = {h, static_cast<int>(k), owner_id};
+            ++ghost_count_;
+        }
+    }
+    return true;
+}
+
+bool DomainNode::exchangeEffects()
+{
+    for (Message& m : outgoing_)
+        m.clear();
+
+    for (const GhostEffect& e : field_.ghostEffects())
+    {
+        const GhostOrigin& origin = ghost_origin_[e.ghost.index];
+        if (origin.local != e.ghost) continue;
+        append(outgoing_[origin.peer], origin.owner_id);
+        append(outgoing_[origin.peer], static_cast<uint8_t>(e.type));
+    }
+    field_.clearGhostEffects();
+    field_.removeGhosts();
+
+    if (!transport_->exchange(neighbors_, outgoing_, incoming_)) return false;
+
+    for (const Message& m : incoming_)
+    {
+        for (std::size_t off = 0; off + kEffectRecord <= m.size(); off += kEffectRecord)
+        {
+            const uint32_t id = readAt<uint32_t>(m, off);
+            const auto type = static_cast<GhostEffectType>(readAt<uint8_t>(m, off + sizeof(uint32_t)));
+            field_.applyGhostEffect(SlotHandle::fromPacked(id), type);
+        }
+    }
+    return true;
+}
+
+bool DomainNode::migrate()
+{
+    for (Message& m : outgoing_)
+        m.clear();
+
+    leaving_.clear();
+    for (const Creature& c : field_.creatures())
+    {
+        if (!c.isAlive()) continue;
+        const int owner = layout_.ownerOf(c.position());
+        if (owner == rank_ || neighbors_.empty()) continue;
+
+        // Straight to the new owner if it's a neighbor (it is unless the
+        // creature outran the halo), else towards it.
+        std::size_t to = 0;
+        float best = INFINITY;
+        for (std::size_t k = 0; k < neighbors_.size(); ++k)
+        {
+            const float d2 = neighbors_[k] == owner ? -1.0f : neighbor_rects_[k].distanceSquared(c.position());
+            if (d2 < best)
+            {
+                best = d2;
+                to = k;
+            }
+        }
+        append(outgoing_[to], c);
+        leaving_.push_back(SlotHandle::fromPacked(c.id()));
+    }
+    for (SlotHandle h : leaving_)
+        field_.releaseCreature(h);
+
+    if (!transport_->exchange(neighbors_, outgoing_, incoming_)) return false;
+
+    migrant_count_ = leaving_.size();
+    for (const Message& m : incoming_)
+    {
+        for (std::size_t off = 0; off + kMigrantRecord <= m.size(); off += kMigrantRecord)
+            field_.adoptCreature(readCreature(m, off).get(), GhostKind::None);
+    }
+    return true;
+}
@@ -0,0 +1,112 @@
+//
+//  domain.hpp
+//  Volterria
+//
+//  Created by Devin R Cohen on 10/18/26.
+//
+
+#pragma once
+
+// Domain decomposition: the world split into a grid of rectangular
+// subdomains, each stepped by its own DomainNode (a thread or a process)
+// with its own Field, talking to its neighbors over a HaloTransport.
+//
+// Each step a node
+//   1. sends its neighbors ghost copies of the creatures within the halo
+//      width of their rectangles, and adopts theirs;
+//   2. steps its Field;
+//   3. sends back what happened to their ghosts (eaten, fed, mated) and
+//      applies what happened to its own creatures over there;
+//   4. drops its ghosts and migrates creatures that left its rectangle to
+//      the neighbor that owns them now.
+//
+// Approximations against a single Field: ghosts are as of the start of
+// the step, and a cross-boundary pair is resolved by the lower rank only,
+// from its own view. Grass belongs to the subdomain holding the patch's
+// center. Creatures travel as raw bytes, so all ranks must be the same
+// build.
+
+#include <memory>
+#include <vector>
+
+#include "field.hpp"
+#include "halo_transport.hpp"
+
+struct DomainRect
+{
+    float x0 = 0.0f, y0 = 0.0f, x1 = 0.0f, y1 = 0.0f;
+
+    // Squared distance from p to the rectangle; 0 inside.
+    float distanceSquared(const Vec2& p) const noexcept;
+};
+
+// tiles_x * tiles_y equal rectangles over the world; rank = ty * tiles_x + tx.
+class DomainLayout
+{
+public:
+    DomainLayout(const Settings& settings, int tiles_x, int tiles_y);
+
+    int size() const noexcept { return tiles_x_ * tiles_y_; }
+    DomainRect rect(int rank) const noexcept;
+    int ownerOf(const Vec2& p) const noexcept; // clamped, so every point has one
+
+    // Ranks whose rectangles come within `halo` of this one's, in rank
+    // order. Symmetric, as HaloTransport::exchange() needs.
+    std::vector<int> neighborsOf(int rank, float halo) const;
+
+private:
+    float x_min_, y_min_, tile_w_, tile_h_;
+    int tiles_x_, tiles_y_;
+};
+
+class DomainNode
+{
+public:
+    // The transport's rank picks the subdomain and its size must match the
+    // layout. Every rank must start from the same settings with the same
+    // non-zero rng_seed: each spawns the whole initial population and
+    // keeps its share.
+    DomainNode(const Settings& settings, int tiles_x, int tiles_y, std::unique_ptr<HaloTransport> transport);
+
+    void reset();
+    // One step of the whole decomposed world; every rank must call it with
+    // the same dt. False if the transport failed.
+    bool step(float dt);
+
+    const Field& field() const noexcept { return field_; }
+    int rank() const noexcept { return rank_; }
+    const DomainRect& rect() const noexcept { return rect_; }
+    const std::vector<int>& neighbors() const noexcept { return neighbors_; }
+    std::size_t ghostsLastStep() const noexcept { return ghost_count_; }
+    std::size_t migrantsLastStep() const noexcept { return migrant_count_; }
+
+private:
+    bool exchangeHalos();
+    bool exchangeEffects();
+    bool migrate();
+
+    Field field_;
+    DomainLayout layout_;
+    std::unique_ptr<HaloTransport> transport_;
+    int rank_;
+    DomainRect rect_;
+    float halo_;
+    std::vector<int> neighbors_;
+    std::vector<DomainRect> neighbor_rects_;
+
+    // Where each ghost came from, by local slot, so effects can be routed
+    // back to (owner rank, owner's id).
+    struct GhostOrigin
+    {
+        SlotHandle local;
+        int peer = -1; // index into neighbors_
+        uint32_t owner_id = 0;
+    };
+    std::vector<GhostOrigin> ghost_origin_;
+
+    std::vector<HaloTransport::Message> outgoing_;
+    std::vector<HaloTransport::Message> incoming_;
+    std::vector<SlotHandle> leaving_;
+    std::size_t ghost_count_ = 0;
+    std::size_t migrant_count_ = 0;
+};
@@ -6,6 +6,8 @@
 //
 
 #include "field.hpp"
+#include "creature_kernel.hpp"
+#include "species_policy.hpp"
 
 #include <algorithm>
 #include <cmath>
@@ -14,27 +16,60 @@
 
 namespace
 {
+    // Grid cost model weights, in units of one distance test.
+    constexpr double kGridCellVisitCost = 2.0; // bounds checks + cell list overhead per visited cell
+    constexpr double kGridCellClearCost = 1.0; // per cell, per rebuild
+    constexpr double kGridRetuneGain    = 0.9; // switch only for a 10% predicted saving
+    
+    // Creatures per task when the update runs on worker_threads.
+    constexpr std::size_t kUpdateGrain = 1024;
+    
     float distanceSquared(const Vec2& a, const Vec2& b)
     {
         const float dx = a.x - b.x;
         const float dy = a.y - b.y;
         return dx * dx + dy * dy;
     }
+    
+    // Smallest squared distance between two points moving in straight
+    // lines, a0 -> a1 and b0 -> b1, over the same interval.
+    float closestApproachSquared(const Vec2& a0, const Vec2& a1, const Vec2& b0, const Vec2& b1)
+    {
+        const float dx = a0.x - b0.x;         // relative position at the start
+        const float dy = a0.y - b0.y;
+        const float vx = (a1.x - b1.x) - dx;  // relative displacement over the step
+        const float vy = (a1.y - b1.y) - dy;
+        const float vv = vx * vx + vy * vy;
+        const float t = vv > 0.0f ? std::clamp(-(dx * vx + dy * vy) / vv, 0.0f, 1.0f) : 0.0f;
+        const float cx = dx + t * vx;
+        const float cy = dy + t * vy;
+        return cx * cx + cy * cy;
+    }
+    
+    // Spread the low 16 bits of v so there is a zero between each pair.
+    uint32_t spreadBits(uint32_t v)
+    {
+        v &= 0x0000FFFF;
+        v = (v | (v << 8)) & 0x00FF00FF;
+        v = (v | (v << 4)) & 0x0F0F0F0F;
+        v = (v | (v << 2)) & 0x33333333;
+        v = (v | (v << 1)) & 0x55555555;
+        return v;
+    }
+    
+    // Z-order (Morton) key of a cell: nearby cells get nearby keys.
+    uint32_t mortonKey(int cx, int cy)
+    {
+        return spreadBits(static_cast<uint32_t>(cx)) | (spreadBits(static_cast<uint32_t>(cy)) << 1);
+    }
 }
 
 Field::Field(const Settings& settings)
-    : settings_(settings),
-      rng_(std::random_device{}()),
-      x_dist_uniform_(settings_.x_min, settings_.x_max),
-      y_dist_uniform_(settings_.y_min, settings_.y_max),
-      v_dist_uniform_(-settings_.vmax_default, settings_.vmax_default),
-      x_prey_spawn_normal_(settings_.prey_spawn_mean_x, settings_.prey_spawn_stdev),
-      y_prey_spawn_normal_(settings_.prey_spawn_mean_y, settings_.prey_spawn_stdev),
-      x_predator_spawn_normal_(settings_.predator_spawn_mean_x, settings_.predator_spawn_stdev),
-      y_predator_spawn_normal_(settings_.predator_spawn_mean_y, settings_.predator_spawn_stdev),
-      prey_female_dist_(settings_.probability_female_prey),
-      pred_female_dist_(settings_.probability_female_pred)
+    : settings_(settings)
 {
+    settings_.recomputeDerived();
+    seedRandomStreams();
+    configureWorkers();
     //initializeFieldCells();
     //initializeCreatures(DistType::Uniform);
     //initializeCreatures(DistType::Normal);
@@ -43,67 +78,435 @@ Field::Field(const Settings& settings)
 
 void Field::ResetFromSettings()
 {
+    reset(true);
+}
+
+void Field::WarmReset()
+{
+    reset(false);
+}
+
+void Field::reset(bool verbose)
+{
+    settings_.recomputeDerived();
     creatures_.clear();
-    std::cerr << "creatures cleared\n";
+    if (verbose) std::cerr << "creatures cleared\n";
     grassPatches_.clear();
-    x_dist_uniform_ = std::uniform_real_distribution<float>(settings_.x_min, settings_.x_max);
-    y_dist_uniform_ = std::uniform_real_distribution<float>(settings_.y_min, settings_.y_max);
-    v_dist_uniform_ = std::uniform_real_distribution<float>(-settings_.vmax_default, settings_.vmax_default);
-    x_prey_spawn_normal_ = std::normal_distribution<float>(settings_.prey_spawn_mean_x, settings_.prey_spawn_stdev);
-    y_prey_spawn_normal_ = std::normal_distribution<float>(settings_.prey_spawn_mean_y, settings_.prey_spawn_stdev);
-    x_predator_spawn_normal_ = std::normal_distribution<float>(settings_.predator_spawn_mean_x, settings_.predator_spawn_stdev);
-    y_predator_spawn_normal_ = std::normal_distribution<float>(settings_.predator_spawn_mean_y, settings_.predator_spawn_stdev);
-    initializeFieldCells();
-    std::cerr << "field cells initialized\n";
+    sim_time_ = 0.0;
+    step_count_ = 0;
+    neighbor_lists_.invalidate();
+    std::fill(slot_intent_owner_.begin(), slot_intent_owner_.end(), SlotHandle{});
+    perception_cursor_ = 0;
+    timers_.reset(0);
+    tallies_ = FieldTallies{};
+    ghost_effects_.clear();
+    elapsed_sim_seconds_ = 0;
+    cells_dirty_ = true;
+    seedRandomStreams();
+    configureWorkers();
+    if (verbose)
+    {
+        initializeFieldCells();
+        std::cerr << "field cells initialized\n";
+    }
+    else
+    {
+        setCellSize(settings_.cell_size);
+    }
     initializeCreatures(DistType::Normal);
-    std::cerr << "creatures initialized\n";
+    if (verbose) std::cerr << "creatures initialized\n";
     initializeGrass();
-    std::cerr << "grass initialized\n";
+    if (verbose) std::cerr << "grass initialized\n";
+    frame_arena_.reset(); // spawn scratch
+}
+
+void Field::seedRandomStreams()
+{
+    // A fixed rng_seed replays the same run on every reset; 0 draws a new one.
+    seed_ = settings_.rng_seed != 0 ? settings_.rng_seed : RandomStream::entropySeed();
+    spawn_random_.reseed(seed_, 1);
+    wander_random_.reseed(seed_, 2);
+}
+
+void Field::configureWorkers()
+{
+    const int workers = std::max(settings_.worker_threads, 1);
+    if (workers == 1)
+    {
+        scheduler_.reset();
+        node_load_.clear();
+        return;
+    }
+    const bool numa = settings_.numa_tiles;
+    if (scheduler_ && scheduler_->workers() == workers && (scheduler_->topology() != nullptr) == numa)
+        return;
+    if (numa)
+    {
+        const NumaTopology topology = NumaTopology::detect();
+        scheduler_ = std::make_shared<TileScheduler>(workers, &topology);
+    }
+    else
+    {
+        scheduler_ = std::make_shared<TileScheduler>(workers);
+    }
 }
 
 void Field::initializeFieldCells()
 {
-    const int nx = settings_.num_cells_x;
-    const int ny = settings_.num_cells_y;
+    setCellSize(settings_.cell_size);
+    std::cout << "cell size: " << cell_size_ << std::endl;
+    std::cout << num_cells_x_ << " rows.\n";
+    std::cout << num_cells_y_ << " cols.\n";
+}
+
+void Field::setCellSize(float cell_size)
+{
+    // Cell counts follow the current world bounds, so a resized world gets
+    // a grid that covers it. Morton keys take 16 bits per axis.
+    cell_size_ = cell_size;
+    num_cells_x_ = std::clamp((int)std::ceil((settings_.x_max - settings_.x_min) / cell_size_), 1, 1 << 16);
+    num_cells_y_ = std::clamp((int)std::ceil((settings_.y_max - settings_.y_min) / cell_size_), 1, 1 << 16);
+    const int nx = num_cells_x_;
+    const int ny = num_cells_y_;
     actual_cell_width_ = (settings_.x_max - settings_.x_min) / nx;
     actual_cell_height_ = (settings_.y_max - settings_.y_min) / ny;
-    field_cells_.resize(nx);
-    field_cells_.assign(nx, std::vector<FieldCell>(ny));
-    std::cout << "cell size: " << settings_.cell_size << std::endl;
-    std::cout << field_cells_.size() << " rows.\n";
-    std::cout << field_cells_[0].size() << " cols.\n";
+    grid_.configure(nx, ny, settings_.sparse_grid);
+    cells_dirty_ = true;
+    
+    // Keep raster blocks one grid cell across, so a retuned grid doesn't
+    // leave perception searching blocks of the old size.
+    if (!grass_raster_.empty())
+    {
+        const int block = std::max(1, (int)std::lround(cell_size_ / grass_raster_.cellSize()));
+        if (block != grass_raster_.block())
+            grass_raster_.setBlock(block, settings_.min_grass_edible_health);
+    }
+}
+
+void Field::retuneGrid()
+{
+    // Species counts and the density a creature actually sees around it:
+    // sum of (cell count)^2 over cells, per creature, per unit area. A
+    // clumped population reads denser than its mean.
+    double prey = 0.0, predators = 0.0, sum_sq = 0.0;
+    grid_.forEachStats([&](int, int, const CellStats& stats)
+    {
+        const double k = stats.prey + stats.predators;
+        prey += stats.prey;
+        predators += stats.predators;
+        sum_sq += k * k;
+    });
+    const double n = prey + predators;
+    if (n < 2.0) return;
+    const double density = sum_sq / n / (cell_size_ * cell_size_);
+    
+    const double width  = settings_.x_max - settings_.x_min;
+    const double height = settings_.y_max - settings_.y_min;
+    const double reach  = settings_.interaction_radius;
+    
+    // Each creature scanning radius r visits (2 ceil(r/c) + 1)^2 cells,
+    // pays a fixed cost per cell and a distance test per occupant; the
+    // rebuild also clears every cell (a sparse grid only the occupied
+    // ones, at most one per creature). Units are distance tests.
+    auto scan = [&](double c, double r, double searchers, double calibration) {
+        const double side = 2.0 * std::ceil(r / c) + 1.0;
+        return searchers * side * side * (kGridCellVisitCost + calibration * density * c * c);
+    };
+    auto cost = [&](double c, double calibration) {
+        double cells = std::ceil(width / c) * std::ceil(height / c);
+        if (settings_.sparse_grid) cells = std::min(cells, n);
+        return scan(c, settings_.predator_vision_radius, predators, calibration)
+             + scan(c, settings_.prey_vision_radius, prey, calibration)
+             + scan(c, reach, n, calibration)
+             + kGridCellClearCost * cells;
+    };
+    
+    // Calibrate the density term against the pair checks handleInteractions
+    // actually made (each pair is tested once, hence the half).
+    double calibration = 1.0;
+    const double side = 2.0 * std::ceil(reach / cell_size_) + 1.0;
+    const double predicted_pairs = 0.5 * n * side * side * density * cell_size_ * cell_size_;
+    if (pair_checks_per_frame_ > 0 && predicted_pairs > 0.0)
+        calibration = std::clamp(pair_checks_per_frame_ / predicted_pairs, 0.25, 4.0);
+    
+    // Candidates: fractions of the largest vision radius and multiples of
+    // the interaction radius, bounded to a sane number of cells.
+    const double vision = std::max(settings_.predator_vision_radius, settings_.prey_vision_radius);
+    const double min_size = std::max({0.5 * reach, width / 65536.0, height / 65536.0});
+    const double max_size = std::max({width, height, min_size});
+    double best = cell_size_;
+    double best_cost = cost(cell_size_, calibration);
+    const double current_cost = best_cost;
+    auto consider = [&](double c) {
+        c = std::clamp(c, min_size, max_size);
+        const double k = cost(c, calibration);
+        if (k < best_cost) { best = c; best_cost = k; }
+    };
+    for (int m = 1; m <= 16; ++m)
+        consider(vision / m);
+    for (double f : {0.5, 1.0, 1.5, 2.0, 3.0, 4.0})
+        consider(reach * f);
+    
+    // Hysteresis, so the grid doesn't flip between near-equal sizes.
+    if (best != cell_size_ && best_cost < kGridRetuneGain * current_cost)
+        setCellSize(static_cast<float>(best));
 }
 
 void Field::initializeCreatures(DistType spawnDistType)
 {
     creatures_.clear();
     creatures_.reserve((settings_.numprey + settings_.numpred) * 4.0); // preallocate for higher population
-    Vec2 pos, vel;
-    
-    // Spawn prey.
-    for (std::size_t i = 0; i < settings_.numprey; ++i)
-    {
-        pos.x = (spawnDistType == DistType::Normal) ? x_prey_spawn_normal_(rng_) : x_dist_uniform_(rng_);
-        pos.y = (spawnDistType == DistType::Normal) ? y_prey_spawn_normal_(rng_) : y_dist_uniform_(rng_);
-        vel.x = v_dist_uniform_(rng_);
-        vel.y = v_dist_uniform_(rng_);
-        std::bernoulli_distribution is_female(prey_female_dist_);
-        Sex sex = is_female(rng_) == 1 ? Sex::Female : Sex::Male;
-        creatures_.emplace_back(next_creature_id++ ,settings_, SpeciesRole::Prey, sex, pos, vel);
+    spawnPopulation(SpeciesRole::Prey, settings_.numprey, spawnDistType);
+    spawnPopulation(SpeciesRole::Predator, settings_.numpred, spawnDistType);
+}
+
+void Field::spawnPopulation(SpeciesRole role, int count, DistType spawnDistType)
+{
+    const bool prey = (role == SpeciesRole::Prey);
+    const std::size_t n = static_cast<std::size_t>(std::max(count, 0));
+    
+    // Draw every random quantity for the whole batch up front.
+    std::pmr::vector<float> xs(n, &frame_arena_), ys(n, &frame_arena_);
+    std::pmr::vector<float> vels(2 * n, &frame_arena_), rolls(2 * n, &frame_arena_);
+    std::pmr::vector<uint8_t> female(n, &frame_arena_);
+    
+    if (spawnDistType == DistType::Normal)
+    {
+        const float stdev = prey ? settings_.prey_spawn_stdev : settings_.predator_spawn_stdev;
+        spawn_random_.fillNormal(xs.data(), n, prey ? settings_.prey_spawn_mean_x : settings_.predator_spawn_mean_x, stdev);
+        spawn_random_.fillNormal(ys.data(), n, prey ? settings_.prey_spawn_mean_y : settings_.predator_spawn_mean_y, stdev);
+    }
+    else
+    {
+        spawn_random_.fillUniform(xs.data(), n, settings_.x_min, settings_.x_max);
+        spawn_random_.fillUniform(ys.data(), n, settings_.y_min, settings_.y_max);
+    }
+    spawn_random_.fillUniform(vels.data(), 2 * n, -settings_.vmax_default, settings_.vmax_default);
+    spawn_random_.fillBernoulli(female.data(), n, prey ? settings_.probability_female_prey : settings_.probability_female_pred);
+    spawn_random_.fillUniform(rolls.data(), 2 * n, 0.0f, 1.0f);
+    
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        const Sex sex = female[i] ? Sex::Female : Sex::Male;
+        spawnCreature(role, sex, {xs[i], ys[i]}, {vels[2 * i], vels[2 * i + 1]}, {rolls[2 * i], rolls[2 * i + 1]});
         //announceCreature(&creatures_.at(i));
     }
+}
 
-    // Spawn predators.
-    for (std::size_t i = 0; i < settings_.numpred; ++i)
+void Field::spawnCreature(SpeciesRole role, Sex sex, const Vec2& pos, const Vec2& vel,
+                          const CreatureRolls& rolls, uint32_t parent_a, uint32_t parent_b)
+{
+    const SlotHandle handle = creatures_.emplace(creatures_.peekHandle().packed(), settings_, role, sex, pos, vel, rolls);
+    neighbor_lists_.addPending(handle);
+    if (settings_.event_timers)
+        scheduleTimers(handle);
+    emitEvent(FieldEventType::Born, creatures_[creatures_.size() - 1], parent_a, parent_b);
+}
+
+void Field::EnableEvents(std::size_t capacity)
+{
+    events_ = std::make_shared<FieldEventQueue>(capacity);
+}
+
+void Field::emitEvent(FieldEventType type, const Creature& subject, uint32_t other, uint32_t other2)
+{
+    if (subject.isGhost()) return; // its owner reports it
+    ++tallies_.counts[static_cast<int>(type)][static_cast<int>(subject.species())];
+    if (!events_ || events_muted_) return;
+    FieldEvent e;
+    e.type    = type;
+    e.subject = subject.id();
+    e.other   = other;
+    e.other2  = other2;
+    e.species = subject.species();
+    e.x       = subject.position().x;
+    e.y       = subject.position().y;
+    e.time    = static_cast<float>(sim_time_);
+    events_->tryPush(e); // full queue: dropped and counted, never waits on the reader
+}
+
+void Field::captureKeyframe(FieldKeyframe& out) const
+{
+    out.creatures     = creatures_;
+    out.grass         = grassPatches_;
+    out.grass_raster  = grass_raster_.health();
+    out.spawn_random  = spawn_random_;
+    out.wander_random = wander_random_;
+    out.seed          = seed_;
+    out.sim_time      = sim_time_;
+    out.step_count    = step_count_;
+    out.cell_size     = cell_size_;
+    out.slot_intents      = slot_intents_;
+    out.slot_intent_owner = slot_intent_owner_;
+    out.perception_cursor = perception_cursor_;
+    out.tallies           = tallies_;
+    out.neighbor_lists    = neighbor_lists_;
+}
+
+void Field::restoreKeyframe(const FieldKeyframe& keyframe)
+{
+    creatures_     = keyframe.creatures;
+    grassPatches_  = keyframe.grass;
+    grass_raster_.assign(keyframe.grass_raster);
+    spawn_random_  = keyframe.spawn_random;
+    wander_random_ = keyframe.wander_random;
+    seed_          = keyframe.seed;
+    sim_time_      = keyframe.sim_time;
+    step_count_    = keyframe.step_count;
+    slot_intents_      = keyframe.slot_intents;
+    slot_intent_owner_ = keyframe.slot_intent_owner;
+    perception_cursor_ = keyframe.perception_cursor;
+    tallies_           = keyframe.tallies;
+    elapsed_sim_seconds_ = static_cast<int>(sim_time_);
+    if (keyframe.cell_size != cell_size_)
+        setCellSize(keyframe.cell_size); // pair order depends on the grid, so it must match too
+    rebuildCells(); // same grid the original run had between these steps
+    neighbor_lists_ = keyframe.neighbor_lists;
+    rebuildTimers();
+}
+
+uint32_t Field::timerTick(double seconds) const
+{
+    return static_cast<uint32_t>(std::floor(seconds / settings_.timer_resolution));
+}
+
+uint32_t Field::timerPeriod(float seconds) const
+{
+    return std::max<uint32_t>(1, static_cast<uint32_t>(std::lround(seconds / settings_.timer_resolution)));
+}
+
+void Field::scheduleTimers(SlotHandle handle)
+{
+    // A creature's clocks start now: first hunger tick and re-roll one
+    // period out, death once it reaches max age.
+    const Creature& c = *creatures_.get(handle);
+    CreatureTimers& t = creatures_.get(handle)->timers();
+    const uint32_t now = timerTick(sim_time_);
+    t.hunger_due = now + timerPeriod(settings_.hunger_tick_seconds);
+    t.accel_due  = now + timerPeriod(settings_.accel_tick);
+    t.death_due  = now + timerPeriod(c.maxAge() - c.age());
+    enqueueTimers(handle);
+}
+
+void Field::enqueueTimers(SlotHandle handle)
+{
+    const CreatureTimers& t = creatures_.get(handle)->timers();
+    timers_.schedule(t.hunger_due, {handle, CreatureTimer::Hunger});
+    timers_.schedule(t.accel_due,  {handle, CreatureTimer::Accel});
+    timers_.schedule(t.death_due,  {handle, CreatureTimer::Death});
+}
+
+void Field::rebuildTimers()
+{
+    // The due ticks live on the creatures, so the wheel is just an index
+    // over them and can be rebuilt from a keyframe.
+    timers_.reset(timerTick(sim_time_));
+    if (!settings_.event_timers) return;
+    for (std::size_t i = 0; i < creatures_.size(); ++i)
     {
-        pos.x = (spawnDistType == DistType::Normal) ? x_predator_spawn_normal_(rng_) : x_dist_uniform_(rng_);
-        pos.y = (spawnDistType == DistType::Normal) ? y_predator_spawn_normal_(rng_) : y_dist_uniform_(rng_);
-        vel.x = v_dist_uniform_(rng_);
-        vel.y = v_dist_uniform_(rng_);
-        std::bernoulli_distribution is_female(pred_female_dist_);
-        Sex sex = is_female(rng_) == 1 ? Sex::Female : Sex::Male;
-        creatures_.emplace_back(next_creature_id++, settings_, SpeciesRole::Predator, sex, pos, vel);
-        //announceCreature(&creatures_.at(i));
+        if (!creatures_[i].isGhost())
+            enqueueTimers(creatures_.handleAt(i));
+    }
+}
+
+void Field::fireTimers()
+{
+    // Only the creatures with something due this step are touched.
+    timers_.advance(timerTick(sim_time_), [&](uint32_t due, const TimerEntry& entry)
+    {
+        Creature* c = creatures_.get(entry.handle);
+        if (!c || !c->isAlive()) return; // died since it was scheduled
+        CreatureTimers& t = c->timers();
+        switch (entry.kind)
+        {
+            case CreatureTimer::Death:
+                c->kill(DeathCause::OldAge);
+                break;
+            case CreatureTimer::Hunger:
+                c->hungerTick(settings_);
+                if (!c->isAlive()) break; // starved
+                t.hunger_due = due + timerPeriod(settings_.hunger_tick_seconds);
+                timers_.schedule(t.hunger_due, entry);
+                break;
+            case CreatureTimer::Accel:
+                t.accel_ready = true; // spent on the next wander step
+                t.accel_due = due + timerPeriod(settings_.accel_tick);
+                timers_.schedule(t.accel_due, entry);
+                break;
+        }
+    });
+}
+
+void Field::populationCounts(int* prey, int* predators) const
+{
+    *prey = 0;
+    *predators = 0;
+    for (const Creature& c : creatures_)
+    {
+        if (!c.isAlive() || c.isGhost()) continue;
+        if (c.species() == SpeciesRole::Prey) ++*prey;
+        else ++*predators;
+    }
+}
+
+void Field::jumpAhead(double seconds, int prey, int predators)
+{
+    // Templates: the living population as it stands, by species. Ghosts
+    // are copies of a neighbor subdomain's creatures, not ours to clone.
+    std::vector<Creature> like[2];
+    for (const Creature& c : creatures_)
+    {
+        if (c.isAlive() && !c.isGhost())
+            like[static_cast<int>(c.species())].push_back(c);
+    }
+    
+    creatures_.clear();
+    sim_time_ += seconds;
+    elapsed_sim_seconds_ = static_cast<int>(sim_time_);
+    timers_.reset(timerTick(sim_time_));
+    
+    // Scatter each copy about a cell's width around its template, so the
+    // new population reads as a smoothed version of the old one.
+    const float spread = 0.5f * cell_size_;
+    const int want[2] = { std::max(prey, 0), std::max(predators, 0) };
+    for (int s = 0; s < 2; ++s)
+    {
+        if (like[s].empty()) continue; // extinct stays extinct
+        for (int k = 0; k < want[s]; ++k)
+        {
+            const std::size_t pick = std::min(like[s].size() - 1,
+                                              static_cast<std::size_t>(spawn_random_.uniform() * like[s].size()));
+            const Creature& t = like[s][pick];
+            const Vec2 pos{
+                std::clamp(spawn_random_.normal(t.position().x, spread), settings_.x_min, settings_.x_max),
+                std::clamp(spawn_random_.normal(t.position().y, spread), settings_.y_min, settings_.y_max)
+            };
+            const SlotHandle h = creatures_.emplace(creatures_.peekHandle().packed(), t, pos);
+            if (settings_.event_timers)
+                scheduleTimers(h);
+        }
+    }
+    
+    neighbor_lists_.invalidate();
+    rebuildCells();
+}
+
+void Field::removeDeadCreatures()
+{
+    // Walk backwards so whatever eraseAt() swaps into slot i has already
+    // been checked. The scan is O(population); only the erasing is
+    // proportional to the dead, with no compaction of the survivors.
+    for (int i = (int)creatures_.size() - 1; i >= 0; --i)
+    {
+        const Creature& c = creatures_[i];
+        if (c.isAlive()) continue;
+        
+        // Eaten was already reported with its predator in handleInteractions.
+        if (c.deathCause() == DeathCause::Starved)
+            emitEvent(FieldEventType::Starved, c);
+        else if (c.deathCause() == DeathCause::OldAge)
+            emitEvent(FieldEventType::DiedOfAge, c);
+        creatures_.eraseAt(i);
     }
 }
 
@@ -114,20 +517,92 @@ void Field::step(float dt)
     start_time_ = std::chrono::steady_clock::now(); // reassign start_time_
     std::chrono::duration<float> sec = elapsed;
     elapsed_sec_ = elapsed.count();
-
-    //intents_.assign(creatures_.size(), SteeringIntent{});
-    for (auto& col : field_cells_)
+    sim_time_ += dt;
+    elapsed_sim_seconds_ = static_cast<int>(sim_time_);
+    
+    if (scheduler_)
+        node_load_.assign(scheduler_->nodes(), NodeLoad{});
+    
+    // The grid normally carries over from the end of the previous step;
+    // it only needs building here after a reset.
+    if (cells_dirty_)
+        rebuildCells();
+    
+    if (settings_.neighbor_lists)
+        refreshNeighborLists();
+    
+    // Hunger ticks, re-roll credits and old-age deaths that came due.
+    if (settings_.event_timers)
+        fireTimers();
+    
+    // fill intents_
+    computeIntents();
+    
+    // Start-of-step positions for the swept interaction tests. Dense
+    // indices don't move until removeDeadCreatures(), so they line up.
+    std::pmr::vector<Vec2> start_positions(&frame_arena_);
+    if (settings_.swept_interactions)
+    {
+        start_positions.resize(creatures_.size());
+        for (std::size_t i = 0; i < creatures_.size(); ++i)
+            start_positions[i] = creatures_[i].position();
+    }
+    
+    // Two pre-drawn wander components per creature; only those whose
+    // re-roll timer is due actually consume theirs.
+    std::pmr::vector<float> wander_accel(2 * creatures_.size(), &frame_arena_);
+    wander_random_.fillUniform(wander_accel.data(), wander_accel.size(), -settings_.vmax_default, settings_.vmax_default);
+    
+    // Creatures update independently, so the work splits into any ranges.
+    parallelRanges(creatures_.size(), kUpdateGrain, [&](std::size_t begin, std::size_t count)
     {
-        for (auto& cell : col)
+        if (settings_.batched_update)
         {
-            cell.cell_creatures_indices.clear();
-            cell.cell_grassPatches_indices.clear();
-            // might need to clear grass too? those interactions are separate right now
+            CreatureKernel::update(creatures_.data() + begin, intents_.data() + begin, wander_accel.data() + 2 * begin,
+                                   count, dt, settings_);
+            return;
         }
-    }
-    // Assign each creature to a cell (new)
-//    const int nx = settings_.num_cells_x;
-//    const int ny = settings_.num_cells_y;
+        for (std::size_t i = begin; i < begin + count; ++i)
+        {
+            if (creatures_[i].isAlive() && !creatures_[i].isGhost())
+            {
+                creatures_[i].update(dt, settings_, intents_[i], &wander_accel[2 * i]);
+            }
+        }
+    });
+    
+
+    handleGrass(dt);
+    // Apply interactions: eating, mating, and pruning of dead creatures.
+    //computeIntent();
+    handleInteractions(start_positions.empty() ? nullptr : start_positions.data());
+    // Remove any creatures that were killed this frame.
+    removeDeadCreatures();
+    
+    // Retune the grid before any reorder, so the Z-order follows the new cells.
+    if (settings_.auto_cell_size && settings_.cell_retune_interval_steps > 0
+        && step_count_ % settings_.cell_retune_interval_steps == 0)
+        retuneGrid();
+    
+    // Every so often, lay creatures out in Z-order of their cells so the
+    // neighbor scans walk memory that is already in cache.
+    if (settings_.reorder_interval_steps > 0 && step_count_ % settings_.reorder_interval_steps == 0)
+        reorderCreatures();
+    ++step_count_;
+    
+    // Rebuild cell membership from the final positions, so between steps
+    // the grid matches creatures_ and can answer spatial queries.
+    rebuildCells();
+    
+    // All per-step scratch (newborns etc.) is dead by now.
+    frame_arena_.reset();
+}
+
+void Field::rebuildCells()
+{
+    // clear() keeps each cell's capacity, so rebuilding membership only
+    // allocates while a cell is still growing to its busiest size.
+    grid_.clear();
     
     for (int i = 0; i < creatures_.size(); ++i)
     {
@@ -137,59 +612,526 @@ void Field::step(float dt)
         int cx, cy;
         ComputeCellLocation<Creature>(c, &cx, &cy);
         // copy the the index of the creature in the master vector into the cell's own vector
-        field_cells_[cx][cy].cell_creatures_indices.push_back(i);
+        grid_.at(cx, cy).cell_creatures_indices.push_back(i);
+        
+        // Heatmap aggregates ride along with the membership pass.
+        CellStats& stats = grid_.statsAt(cx, cy);
+        if (c.species() == SpeciesRole::Prey) ++stats.prey;
+        else ++stats.predators;
+        stats.hunger_sum += c.normalizedHunger();
+        stats.age_sum += c.normalizedAge();
     }
     
-    // Assign each grass patch to a cell
+    // Assign each grass patch to a cell. Depleted patches are registered
+    // too (perception skips them) so spatial queries still find them.
     for (int i = 0; i < grassPatches_.size(); ++i)
     {
         GrassPatch& g = grassPatches_[i];
-        if (g.health <= 0.0f) continue;
-
         int cx, cy;
         ComputeCellLocation<GrassPatch>(g, &cx, &cy);
         
-        field_cells_[cx][cy].cell_grassPatches_indices.push_back(i);
+        grid_.at(cx, cy).cell_grassPatches_indices.push_back(i);
     }
+    cells_dirty_ = false;
+}
+
+void Field::buildTiles()
+{
+    // Occupied cells, keyed by the tile they fall in. Weighting by
+    // occupancy puts the effort where the creatures are, however they
+    // cluster; the scheduler's stealing evens out the rest.
+    const int T = std::max(settings_.tile_cells, 1);
+    const uint32_t tiles_y = static_cast<uint32_t>((num_cells_y_ + T - 1) / T);
+    // The low half of each key is the visit order, so a plain sort keeps
+    // cells in grid order within a tile (std::stable_sort would allocate).
+    std::pmr::vector<std::pair<uint64_t, const FieldCell*>> cells(&frame_arena_);
+    grid_.forEachCell([&](int cx, int cy, const FieldCell& cell)
+    {
+        if (!cell.cell_creatures_indices.empty())
+        {
+            const uint64_t tile = static_cast<uint32_t>(cx / T) * tiles_y + static_cast<uint32_t>(cy / T);
+            cells.push_back({tile << 32 | cells.size(), &cell});
+        }
+    });
+    std::sort(cells.begin(), cells.end(), [](const auto& a, const auto& b) { return a.first < b.first; });
     
-    // fill intents_
-    computeIntents();
+    tile_items_.clear();
+    tile_starts_.clear();
+    tile_weights_.clear();
+    tile_homes_.clear();
+    const bool numa = settings_.numa_tiles;
+    const uint32_t max_items = static_cast<uint32_t>(std::max(settings_.tile_max_creatures, 1));
+    for (std::size_t c = 0; c < cells.size();)
+    {
+        const uint32_t begin = static_cast<uint32_t>(tile_items_.size());
+        const uint32_t key = static_cast<uint32_t>(cells[c].first >> 32);
+        for (; c < cells.size() && cells[c].first >> 32 == key; ++c)
+        {
+            const std::vector<int>& members = cells[c].second->cell_creatures_indices;
+            tile_items_.insert(tile_items_.end(), members.begin(), members.end());
+        }
+        const uint32_t end = static_cast<uint32_t>(tile_items_.size());
+        for (uint32_t s = begin; s < end; s += max_items)
+        {
+            tile_starts_.push_back(s);
+            tile_weights_.push_back(std::min(max_items, end - s));
+            if (numa)
+                tile_homes_.push_back(static_cast<uint16_t>(homeNode(static_cast<int>(key / tiles_y) * T)));
+        }
+    }
+    tile_starts_.push_back(static_cast<uint32_t>(tile_items_.size()));
+}
+
+int Field::homeNode(int cx) const
+{
+    // Nodes own x strips of whole tiles, so creatures only change hands
+    // (and their cache lines cross sockets) at strip edges.
+    const int T = std::max(settings_.tile_cells, 1);
+    const int tiles_x = std::max((num_cells_x_ + T - 1) / T, 1);
+    return std::min(cx / T, tiles_x - 1) * scheduler_->nodes() / tiles_x;
+}
+
+void Field::addNodeLoad()
+{
+    const std::vector<NodeLoad>& run = scheduler_->nodeLoad();
+    for (std::size_t k = 0; k < run.size() && k < node_load_.size(); ++k)
+    {
+        node_load_[k].tasks        += run[k].tasks;
+        node_load_[k].weight       += run[k].weight;
+        node_load_[k].remote_tasks += run[k].remote_tasks;
+    }
+}
+
+void Field::placeCreaturePages(const uint32_t* node_starts, int nodes)
+{
+    // node_starts holds nodes + 1 offsets into creature storage.
+    const NumaTopology* topology = scheduler_->topology();
+    for (int k = 0; k < nodes; ++k)
+    {
+        topology->placePages(creatures_.data() + node_starts[k],
+                             (node_starts[k + 1] - node_starts[k]) * sizeof(Creature), k);
+    }
+}
+
+void Field::parallelRanges(std::size_t n, std::size_t grain, FunctionRef<void(std::size_t, std::size_t)> fn)
+{
+    // Uniform work per creature, so plain index ranges of equal weight.
+    const std::size_t chunks = (n + grain - 1) / grain;
+    if (!scheduler_ || chunks <= 1)
+    {
+        fn(0, n);
+        return;
+    }
+    range_weights_.assign(chunks, 1);
+    const bool numa = settings_.numa_tiles;
+    if (numa)
+    {
+        // Creature storage is laid out node by node (see reorderCreatures()),
+        // so a range belongs where its first creature lives.
+        range_homes_.resize(chunks);
+        for (std::size_t t = 0; t < chunks; ++t)
+        {
+            int cx, cy;
+            ComputeCellLocation<Creature>(creatures_[t * grain], &cx, &cy);
+            range_homes_[t] = static_cast<uint16_t>(homeNode(cx));
+        }
+    }
+    scheduler_->run(range_weights_, [&](std::size_t t, int)
+    {
+        const std::size_t begin = t * grain;
+        fn(begin, std::min(grain, n - begin));
+    }, numa ? &range_homes_ : nullptr);
+    addNodeLoad();
+}
+
+float Field::maxNeighborListDisplacement() const
+{
+    float max_d2 = 0.0f;
+    for (std::size_t i = 0; i < creatures_.size(); ++i)
+    {
+        const SlotHandle h = creatures_.handleAt(i);
+        if (neighbor_lists_.hasList(h))
+            max_d2 = std::max(max_d2, distanceSquared(creatures_[i].position(), neighbor_lists_.reference(h)));
+    }
+    return std::sqrt(max_d2);
+}
+
+void Field::refreshNeighborLists()
+{
+    // Rebuild once someone has moved half the skin, or once enough
+    // newborns have piled up that scanning the pending list costs more
+    // than it saves.
+    const std::size_t pending_limit = creatures_.size() / 16 + 8;
+    if (neighbor_lists_.built()
+        && neighbor_lists_.pending().size() <= pending_limit
+        && maxNeighborListDisplacement() <= 0.5f * settings_.neighbor_skin)
+        return;
     
+    // The grid is current here (rebuilt at the end of the last step), so
+    // the lists come from the usual cell scan, once, at a wider radius.
+    neighbor_lists_.beginBuild(creatures_.slotCount());
     for (int i = 0; i < (int)creatures_.size(); ++i)
     {
-        if (creatures_[i].isAlive())
+        const Creature& A = creatures_[i];
+        if (!A.isAlive()) continue;
+        
+        const float vision = (A.species() == SpeciesRole::Predator)
+            ? settings_.predator_vision_radius
+            : settings_.prey_vision_radius;
+        const float radius = std::max(vision, settings_.interaction_radius) + settings_.neighbor_skin;
+        const float radius2 = radius * radius;
+        const float near = settings_.interaction_radius + settings_.neighbor_skin;
+        const float near2 = near * near;
+        const int maxOffset = (int)std::ceil(radius / cell_size_);
+        
+        int cx, cy;
+        ComputeCellLocation<Creature>(A, &cx, &cy);
+        neighbor_lists_.beginList(creatures_.handleAt(i), A.position());
+        for (int nx = std::max(cx - maxOffset, 0); nx <= std::min(cx + maxOffset, num_cells_x_ - 1); ++nx)
+        {
+            for (int ny = std::max(cy - maxOffset, 0); ny <= std::min(cy + maxOffset, num_cells_y_ - 1); ++ny)
+            {
+                const FieldCell* cell = grid_.find(nx, ny);
+                if (!cell) continue;
+                for (int idx : cell->cell_creatures_indices)
+                {
+                    if (idx == i) continue;
+                    const float d2 = distanceSquared(A.position(), creatures_[idx].position());
+                    if (d2 <= radius2)
+                        neighbor_lists_.push(creatures_.handleAt(idx), d2 <= near2);
+                }
+            }
+        }
+        neighbor_lists_.endList();
+    }
+}
+
+void Field::cellRange(float x0, float y0, float x1, float y1,
+                      int* cx0, int* cy0, int* cx1, int* cy1) const
+{
+    const float cell_size = cell_size_;
+    *cx0 = std::clamp((int)std::floor((x0 - settings_.x_min) / cell_size), 0, num_cells_x_ - 1);
+    *cy0 = std::clamp((int)std::floor((y0 - settings_.y_min) / cell_size), 0, num_cells_y_ - 1);
+    *cx1 = std::clamp((int)std::floor((x1 - settings_.x_min) / cell_size), 0, num_cells_x_ - 1);
+    *cy1 = std::clamp((int)std::floor((y1 - settings_.y_min) / cell_size), 0, num_cells_y_ - 1);
+}
+
+void Field::queryCreaturesInRect(float x0, float y0, float x1, float y1, std::vector<int>& out) const
+{
+    out.clear();
+    if (cells_dirty_ || x1 < x0 || y1 < y0) return;
+    
+    int cx0, cy0, cx1, cy1;
+    cellRange(x0, y0, x1, y1, &cx0, &cy0, &cx1, &cy1);
+    for (int cx = cx0; cx <= cx1; ++cx)
+    {
+        for (int cy = cy0; cy <= cy1; ++cy)
         {
-            creatures_[i].update(dt, settings_, intents_[i]);
+            const FieldCell* cell = grid_.find(cx, cy);
+            if (!cell) continue;
+            for (int idx : cell->cell_creatures_indices)
+            {
+                // Edge cells straddle the rectangle; creatures past the world
+                // bounds were clamped into a border cell, so test the point.
+                const Vec2& p = creatures_[idx].position();
+                if (p.x >= x0 && p.x <= x1 && p.y >= y0 && p.y <= y1)
+                    out.push_back(idx);
+            }
         }
     }
+}
+
+void Field::queryGrassInRect(float x0, float y0, float x1, float y1, std::vector<int>& out) const
+{
+    out.clear();
+    if (cells_dirty_ || x1 < x0 || y1 < y0) return;
+    
+    // A patch is visible if its disk touches the rectangle, so widen the
+    // cell range by the largest radius.
+    float r = 0.0f;
+    for (const GrassPatch& g : grassPatches_) r = std::max(r, g.radius);
     
+    int cx0, cy0, cx1, cy1;
+    cellRange(x0 - r, y0 - r, x1 + r, y1 + r, &cx0, &cy0, &cx1, &cy1);
+    for (int cx = cx0; cx <= cx1; ++cx)
+    {
+        for (int cy = cy0; cy <= cy1; ++cy)
+        {
+            const FieldCell* cell = grid_.find(cx, cy);
+            if (!cell) continue;
+            for (int gi : cell->cell_grassPatches_indices)
+            {
+                const GrassPatch& g = grassPatches_[gi];
+                const float nx = std::clamp(g.center.x, x0, x1);
+                const float ny = std::clamp(g.center.y, y0, y1);
+                if (distanceSquared(g.center, {nx, ny}) <= g.radius * g.radius)
+                    out.push_back(gi);
+            }
+        }
+    }
+}
 
-    handleGrass(dt);
-    // Apply interactions: eating, mating, and pruning of dead creatures.
-    //computeIntent();
-    handleInteractions();
-    // Remove any creatures that were killed this frame.
-    creatures_.erase(
-        std::remove_if(creatures_.begin(), creatures_.end(),
-                       [](const Creature& c) { return !c.isAlive(); }),
-        creatures_.end());
+void Field::densityHeatmap(int width, int height, std::vector<HeatmapBin>& out) const
+{
+    const int nx = num_cells_x_;
+    const int ny = num_cells_y_;
+    width  = std::clamp(width, 1, nx);
+    height = std::clamp(height, 1, ny);
+    
+    out.assign(width * height, HeatmapBin{});
+    if (grid_.numCellsX() != nx || grid_.numCellsY() != ny) return;
+    
+    // Sum cells into bins, then turn the sums into means.
+    grid_.forEachStats([&](int cx, int cy, const CellStats& stats)
+    {
+        HeatmapBin& bin = out[(cy * height / ny) * width + cx * width / nx];
+        bin.prey        += stats.prey;
+        bin.predators   += stats.predators;
+        bin.mean_hunger += stats.hunger_sum;
+        bin.mean_age    += stats.age_sum;
+    });
+    for (HeatmapBin& bin : out)
+    {
+        const float n = bin.prey + bin.predators;
+        if (n > 0.0f)
+        {
+            bin.mean_hunger /= n;
+            bin.mean_age /= n;
+        }
+    }
 }
 
-void Field::handleInteractions()
+void Field::reorderCreatures()
+{
+    const std::size_t n = creatures_.size();
+    if (n < 2) return;
+    
+    // (morton key << 32 | current index): sorting keeps same-cell creatures
+    // in their existing relative order, so the result is deterministic.
+    std::pmr::vector<uint64_t> keyed(n, &frame_arena_);
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        int cx, cy;
+        ComputeCellLocation<Creature>(creatures_[i], &cx, &cy);
+        keyed[i] = (static_cast<uint64_t>(mortonKey(cx, cy)) << 32) | i;
+    }
+    std::sort(keyed.begin(), keyed.end());
+    
+    std::pmr::vector<uint32_t> order(n, &frame_arena_);
+    const bool numa = scheduler_ && settings_.numa_tiles;
+    const bool by_species = settings_.segregate_species;
+    if (!numa && !by_species)
+    {
+        for (std::size_t k = 0; k < n; ++k)
+            order[k] = static_cast<uint32_t>(keyed[k]);
+        creatures_.permute(order.data());
+        return;
+    }
+    
+    // Bucket-major, Z-order within each bucket. NUMA: a node's creatures
+    // are one contiguous run whose pages can live on that node. By
+    // species: within that, prey then predators, so update blocks hold a
+    // single species and run its specialized path.
+    const int nodes = numa ? scheduler_->nodes() : 1;
+    const int per_node = by_species ? 2 : 1;
+    std::pmr::vector<uint16_t> bucket(n, &frame_arena_);
+    std::pmr::vector<uint32_t> starts(nodes * per_node + 1, 0, &frame_arena_);
+    for (std::size_t k = 0; k < n; ++k)
+    {
+        const Creature& c = creatures_[static_cast<uint32_t>(keyed[k])];
+        int node = 0;
+        if (numa)
+        {
+            int cx, cy;
+            ComputeCellLocation<Creature>(c, &cx, &cy);
+            node = homeNode(cx);
+        }
+        const int species = by_species ? static_cast<int>(c.species()) : 0;
+        bucket[k] = static_cast<uint16_t>(node * per_node + species);
+        ++starts[bucket[k] + 1];
+    }
+    for (std::size_t k = 0; k + 1 < starts.size(); ++k)
+        starts[k + 1] += starts[k];
+    std::pmr::vector<uint32_t> next(starts.begin(), starts.end() - 1, &frame_arena_);
+    for (std::size_t k = 0; k < n; ++k)
+        order[next[bucket[k]]++] = static_cast<uint32_t>(keyed[k]);
+    creatures_.permute(order.data());
+    
+    if (numa)
+    {
+        std::pmr::vector<uint32_t> node_starts(nodes + 1, &frame_arena_);
+        for (int k = 0; k <= nodes; ++k)
+            node_starts[k] = starts[k * per_node];
+        placeCreaturePages(node_starts.data(), nodes);
+    }
+}
+
+void Field::handleInteractions(const Vec2* start_positions)
 {
     int pairChecks = 0;
     const float interaction_radius2 = settings_.interaction_radius * settings_.interaction_radius;
-    const int maxOffset = std::ceil(settings_.interaction_radius / settings_.cell_size); // use predator vision since it's largest in current implementation, this will probably change though.
-    std::vector<Creature> newborns;
+    
+    // A swept test can catch a pair whose end positions are up to the sum
+    // of the two displacements further apart than the radius. Each such
+    // pair is resolved by whichever of the two moved further (the lower
+    // index on a tie), so a creature only has to search out to twice its
+    // own displacement: one fast mover widens its own scan, not everyone's.
+    std::pmr::vector<float> moved(&frame_arena_);
+    if (start_positions)
+    {
+        moved.resize(creatures_.size());
+        for (std::size_t i = 0; i < creatures_.size(); ++i)
+            moved[i] = std::sqrt(distanceSquared(start_positions[i], creatures_[i].position()));
+    }
+    const int baseOffset = std::ceil(settings_.interaction_radius / cell_size_); // use predator vision since it's largest in current implementation, this will probably change though.
+    
+    // The lists were built at search radius + skin, so they still hold
+    // every pair that can touch this step as long as nobody has strayed
+    // more than half the skin from where they were built. Start positions
+    // were checked in refreshNeighborLists(); motion in between is a
+    // straight line, so checking the end positions covers the whole step.
+    const bool use_lists = settings_.neighbor_lists && neighbor_lists_.built()
+                        && maxNeighborListDisplacement() <= 0.5f * settings_.neighbor_skin;
+    
+    std::pmr::vector<Birth> newborns(&frame_arena_);
     newborns.reserve(creatures_.size() / 4); // approximation
     
     const int originalCount = static_cast<int>(creatures_.size()); // compare vs settings_.creature_threshold
+    
+    // What a ghost went through here is its owner's to apply.
+    auto noteGhost = [&](const Creature& c, GhostEffectType type)
+    {
+        if (c.isGhost())
+            ghost_effects_.push_back({SlotHandle::fromPacked(c.id()), type});
+    };
     // consider making this a function pairCheck() -- no args because everything is taken from settings or private properties
     for (int i = 0; i < originalCount; ++i)
     {
         // loop over master vector
         Creature& A = creatures_[i];
         if(!A.isAlive()) continue;
+        
+        auto tryPair = [&](int idx)
+        {
+            if (idx < 0) return; // died since the lists were built
+            // no self or duplicate interaction
+            if (idx == i) return;
+            if (moved.empty() ? idx < i : moved[idx] > moved[i] || (moved[idx] == moved[i] && idx < i)) return;
+            Creature& B = creatures_[idx];
+            
+            // no dead interactions
+            if (!B.isAlive()) return;
+            
+            // Across a subdomain boundary exactly one side resolves a pair:
+            // ghosts never meet each other, and Observe ghosts only watch.
+            if (A.isGhost() && B.isGhost()) return;
+            if (A.ghostKind() == GhostKind::Observe || B.ghostKind() == GhostKind::Observe) return;
+      
+            // Closest approach during the step, so fast movers at
+            // large dt can't pass through each other between frames.
+            float dist2 = start_positions
+                ? closestApproachSquared(start_positions[i], A.position(), start_positions[idx], B.position())
+                : distanceSquared(A.position(), B.position());
+            pairChecks++;
+            if (dist2 > interaction_radius2) return;
+            if (dist2 <= interaction_radius2)
+            {
+                if (!A.isAlive() || !B.isAlive()) return;
+                
+                // predator/prey interaction
+                if (A.species() != B.species()) // one of these is the hunter
+                {
+                    Creature* predator = nullptr;
+                    Creature* prey     = nullptr;
+                    
+                    if (A.species() == SpeciesRole::Predator)
+                    {
+                        predator = &A;
+                        prey     = &B;
+                    }
+                    else
+                    {
+                        predator = &B;
+                        prey     = &A;
+                    }
+                    if (!predator || !prey || !prey->isAlive())
+                        return;
+                    
+                    // Simple rule: predator eats prey if its fullness is below the
+                    // configured threshold.
+                    if (predator->hunger() <= settings_.pred_hunger_threshold)
+                    {
+                        predator->onEat(settings_);
+                        prey->kill(DeathCause::Eaten);
+                        emitEvent(FieldEventType::Eaten, *prey, predator->id());
+                        noteGhost(*predator, GhostEffectType::Fed);
+                        noteGhost(*prey, GhostEffectType::Eaten);
+                    }
+                } else { // both are the same species, mate logic
+                    // Are they even alive?
+                    if (!A.isAlive() || !B.isAlive())
+                        return;
+                    
+                    // Are they even compatible?
+                    if (A.sex() == B.sex())
+                        return;
+                    
+                    const bool is_prey = (B.species() == SpeciesRole::Prey);
+                    
+                    const float libido_threshold =
+                    is_prey ? settings_.prey_libido_threshold
+                    : settings_.pred_libido_threshold;
+                    if (A.libido() >= libido_threshold &&
+                        B.libido() >= libido_threshold)
+                    {
+                        // Spawn a child at the midpoint of the parents' positions.
+//                                Vec2 child_pos{
+//                                    0.5f * (A.position().x + B.position().x),
+//                                    0.5f * (A.position().y + B.position().y)
+//                                };
+                        Vec2 child_vel{
+                            spawn_random_.uniform(-settings_.vmax_default, settings_.vmax_default),
+                            spawn_random_.uniform(-settings_.vmax_default, settings_.vmax_default)
+                        };
+                        Vec2 child_pos = 0.5 * (A.position() + B.position());
+                        
+                        const float p_female = is_prey ? settings_.probability_female_prey
+                                                       : settings_.probability_female_pred;
+                        Sex sex = spawn_random_.bernoulli(p_female) ? Sex::Female : Sex::Male;
+                        // average the hunger of the parents so baby isn't magically full;
+                        // prevents perpetual species growth if reproduction rate outpaces prey population decline
+                        const float hunger = (A.hunger() + B.hunger())/2; // average the hunger of the parents so baby isn't magically full,
+                        //creatures_.push_back(newborn);
+                        CreatureRolls rolls{spawn_random_.uniform(), spawn_random_.uniform()};
+                        newborns.push_back({A.species(), sex, child_pos, child_vel, hunger, rolls, A.id(), B.id()});
+                        if (A.isGhost()) emitEvent(FieldEventType::Mated, B, A.id());
+                        else emitEvent(FieldEventType::Mated, A, B.id());
+                        //announceCreature(&newborns.front());
+                        //announceCreature(&newborn);
+                        A.onMate(settings_);
+                        B.onMate(settings_);
+                        noteGhost(A, GhostEffectType::Mated);
+                        noteGhost(B, GhostEffectType::Mated);
+                    }
+                }
+            }
+        };
+        
+        // Cached candidates when the lists still cover this step's motion;
+        // otherwise the cell scan below.
+        const SlotHandle self = creatures_.handleAt(i);
+        if (use_lists && neighbor_lists_.hasList(self))
+        {
+            for (SlotHandle h : neighbor_lists_.nearList(self))
+                tryPair(creatures_.denseIndex(h));
+            for (SlotHandle h : neighbor_lists_.pending())
+                tryPair(creatures_.denseIndex(h));
+            continue;
+        }
+        
+        const int maxOffset = moved.empty()
+            ? baseOffset
+            : static_cast<int>(std::ceil((settings_.interaction_radius + 2.0f * moved[i]) / cell_size_));
         int cx, cy;
         ComputeCellLocation<Creature>(creatures_[i], &cx, &cy);
         // for each adjacent/cattycorner cell
@@ -203,103 +1145,76 @@ void Field::handleInteractions()
                 int nx = cx + dx;
                 int ny = cy + dy;
                 
-                if (nx < 0 || nx >= settings_.num_cells_x) continue; // horizontally OOB
-                if (ny < 0 || ny >= settings_.num_cells_y) continue; // vertically OOB
+                if (nx < 0 || nx >= num_cells_x_) continue; // horizontally OOB
+                if (ny < 0 || ny >= num_cells_y_) continue; // vertically OOB
                 
-                FieldCell& cell = field_cells_[nx][ny];
+                const FieldCell* found = grid_.find(nx, ny);
+                if (!found) continue; // empty sparse cell
+                const FieldCell& cell = *found;
                 for (int idx : cell.cell_creatures_indices)
-                {
-                    // no self or duplicate interaction
-                    if (idx <= i) continue;
-                    Creature& B = creatures_[idx];
-                    
-                    // no dead interactions
-                    if (!B.isAlive()) continue;
-      
-                    float dist2 = distanceSquared(A.position(), B.position());
-                    pairChecks++;
-                    if (dist2 > interaction_radius2) continue;
-                    if (dist2 <= interaction_radius2)
-                    {
-                        if (!A.isAlive() || !B.isAlive()) continue;
-                        
-                        // predator/prey interaction
-                        if (A.species() != B.species()) // one of these is the hunter
-                        {
-                            Creature* predator = nullptr;
-                            Creature* prey     = nullptr;
-                            
-                            if (A.species() == SpeciesRole::Predator)
-                            {
-                                predator = &A;
-                                prey     = &B;
-                            }
-                            else
-                            {
-                                predator = &B;
-                                prey     = &A;
-                            }
-                            if (!predator || !prey || !prey->isAlive())
-                                continue;
-                            
-                            // Simple rule: predator eats prey if its fullness is below the
-                            // configured threshold.
-                            if (predator->hunger() <= settings_.pred_hunger_threshold)
-                            {
-                                predator->onEat(settings_);
-                                prey->kill();
-                            }
-                        } else { // both are the same species, mate logic
-                            // Are they even alive?
-                            if (!A.isAlive() || !B.isAlive())
-                                continue;
-                            
-                            // Are they even compatible?
-                            if (A.sex() == B.sex())
-                                continue;
-                            
-                            const bool is_prey = (B.species() == SpeciesRole::Prey);
-                            
-                            const float libido_threshold =
-                            is_prey ? settings_.prey_libido_threshold
-                            : settings_.pred_libido_threshold;
-                            if (A.libido() >= libido_threshold &&
-                                B.libido() >= libido_threshold)
-                            {
-                                // Spawn a child at the midpoint of the parents' positions.
-//                                Vec2 child_pos{
-//                                    0.5f * (A.position().x + B.position().x),
-//                                    0.5f * (A.position().y + B.position().y)
-//                                };
-                                Vec2 child_vel{
-                                    v_dist_uniform_(rng_),
-                                    v_dist_uniform_(rng_)
-                                };
-                                Vec2 child_pos = 0.5 * (A.position() + B.position());
-                                
-                                std::bernoulli_distribution is_female(prey_female_dist_);
-                                Sex sex = is_female(rng_) == 1 ? Sex::Female : Sex::Male;
-                                Creature newborn(next_creature_id++,settings_, A.species(), sex, child_pos, child_vel);
-                                // average the hunger of the parents so baby isn't magically full;
-                                // prevents perpetual species growth if reproduction rate outpaces prey population decline
-                                newborn.setHunger((A.hunger() + B.hunger())/2); // average the hunger of the parents so baby isn't magically full,
-                                //creatures_.push_back(newborn);
-                                newborns.emplace_back(std::move(newborn));
-                                //announceCreature(&newborns.front());
-                                //announceCreature(&newborn);
-                                A.onMate(settings_);
-                                B.onMate(settings_);
-                            }
-                        }
-                    }
-                }
+                    tryPair(idx);
             }
         }
     }
     
     pair_checks_per_frame_ = pairChecks;
-    for (Creature& c : newborns)
-        creatures_.push_back(std::move(c));
+    for (const Birth& b : newborns)
+    {
+        spawnCreature(b.species, b.sex, b.position, b.velocity, b.rolls, b.parent_a, b.parent_b);
+        creatures_[creatures_.size() - 1].setHunger(b.hunger);
+    }
+}
+
+SlotHandle Field::adoptCreature(const Creature& state, GhostKind kind)
+{
+    const SlotHandle handle = creatures_.emplace(creatures_.peekHandle().packed(), state, state.position());
+    creatures_.get(handle)->setGhostKind(kind);
+    neighbor_lists_.addPending(handle);
+    // A migrant keeps its clocks; the due ticks came with it and the
+    // subdomains step in lockstep, so they still mean the same time.
+    if (kind == GhostKind::None && settings_.event_timers)
+        enqueueTimers(handle);
+    cells_dirty_ = true;
+    return handle;
+}
+
+bool Field::releaseCreature(SlotHandle handle)
+{
+    if (!creatures_.erase(handle)) return false; // wheel entries go stale and are dropped when they fire
+    cells_dirty_ = true;
+    return true;
+}
+
+void Field::removeGhosts()
+{
+    for (int i = (int)creatures_.size() - 1; i >= 0; --i)
+    {
+        if (creatures_[i].isGhost())
+        {
+            creatures_.eraseAt(i);
+            cells_dirty_ = true;
+        }
+    }
+}
+
+bool Field::applyGhostEffect(SlotHandle owned, GhostEffectType type)
+{
+    Creature* c = creatures_.get(owned);
+    if (!c || !c->isAlive() || c->isGhost()) return false; // already gone here
+    switch (type)
+    {
+        case GhostEffectType::Eaten:
+            c->kill(DeathCause::Eaten);
+            emitEvent(FieldEventType::Eaten, *c);
+            break;
+        case GhostEffectType::Fed:
+            c->onEat(settings_);
+            break;
+        case GhostEffectType::Mated:
+            c->onMate(settings_); // the Mated event came from the side that resolved it
+            break;
+    }
+    return true;
 }
 
 std::vector<CreatureState> Field::snapshot() const
@@ -324,6 +1239,17 @@ void Field::initializeGrass()
 {
     grassPatches_.clear();
     
+    if (settings_.grass_raster)
+    {
+        // Raster blocks line up with the grid's current cells.
+        const int block = std::max(settings_.grass_raster_subdivisions, 1);
+        grass_raster_.configure(settings_.x_min, settings_.y_min,
+                                settings_.x_max - settings_.x_min, settings_.y_max - settings_.y_min,
+                                cell_size_ / block, block, settings_.grass_max_health);
+        return;
+    }
+    grass_raster_.clear();
+    
     const int rows = settings_.grass_patch_rows;
     const int cols = settings_.grass_patch_cols;
     
@@ -355,6 +1281,12 @@ void Field::initializeGrass()
 
 void Field::handleGrass(float dt)
 {
+    if (!grass_raster_.empty())
+    {
+        handleGrassRaster(dt);
+        return;
+    }
+    
     // Regrow all patches
     for (GrassPatch& g : grassPatches_)
     {
@@ -372,6 +1304,7 @@ void Field::handleGrass(float dt)
             if (remaining <= 0.f) break; // grass patch is "dead," must regrow
             if (!g.contains(c.position())) continue; // not even within the grass patch, skip
             if (!c.isAlive()) continue; // creature is dead lmao, skip
+            if (c.isGhost()) continue; // grazes in its own subdomain
             if (c.species() == SpeciesRole::Predator) continue; // not a prey, skip
             if (c.hunger() >= settings_.prey_hunger_threshold) continue; // not hungry enough, skip
             //std::cout << "hunger: " << c.hunger() << std::endl;
@@ -388,6 +1321,50 @@ void Field::handleGrass(float dt)
     
 }
 
+void Field::handleGrassRaster(float dt)
+{
+    // Whole rows per task; regrowth and diffusion touch no creatures.
+    const std::size_t rows = grass_raster_.rows();
+    const std::size_t grain = std::max<std::size_t>(1, (1 << 16) / grass_raster_.cols());
+    const float regrow = settings_.grass_regrow_rate * dt;
+    const float max_health = settings_.grass_max_health;
+    parallelRanges(rows, grain, [&](std::size_t begin, std::size_t count)
+    {
+        grass_raster_.regrow(static_cast<int>(begin), static_cast<int>(begin + count), regrow, max_health);
+    });
+    
+    if (settings_.grass_diffusion_rate > 0.0f)
+    {
+        const float k = std::min(settings_.grass_diffusion_rate * dt, 0.25f); // explicit stencil's stability limit
+        grass_raster_.beginDiffusion();
+        parallelRanges(rows, grain, [&](std::size_t begin, std::size_t count)
+        {
+            grass_raster_.diffuse(static_cast<int>(begin), static_cast<int>(begin + count), k);
+        });
+    }
+    
+    // Each hungry prey bites the cell it stands in.
+    const float bite = settings_.grass_eat_rate * dt;
+    const float min_health = std::max(settings_.min_grass_edible_health, 0.0f);
+    for (Creature& c : creatures_)
+    {
+        if (!c.isAlive() || c.isGhost()) continue;
+        if (c.species() != SpeciesRole::Prey) continue;
+        if (c.hunger() >= settings_.prey_hunger_threshold) continue;
+        const int cell = grass_raster_.cellAt(c.position());
+        if (grass_raster_.health(cell) <= min_health) continue;
+        grass_raster_.graze(cell, bite);
+        c.add_hunger(settings_.prey_hunger_restore_rate * dt, settings_.prey_hunger_max);
+    }
+    
+    // What perception searches next step.
+    const std::size_t block_rows = grass_raster_.blockRows();
+    parallelRanges(block_rows, std::max<std::size_t>(1, grain / grass_raster_.block()), [&](std::size_t begin, std::size_t count)
+    {
+        grass_raster_.refreshBlocks(static_cast<int>(begin), static_cast<int>(begin + count), min_health);
+    });
+}
+
 void Field::SetNumPrey(int num) {
     settings_.numprey = num;
 }
@@ -400,16 +1377,108 @@ void Field::SetFieldDimensions(float width, float height)
 {
     settings_.x_max = settings_.x_min + width;
     settings_.y_max = settings_.y_min + height;
+    resizeWorld();
 }
 
 void Field::SetFieldWidth(float width)
 {
     settings_.x_max = settings_.x_min + width;
+    resizeWorld();
 }
 
 void Field::SetFieldHeight(float height)
 {
     settings_.y_max = settings_.y_min + height;
+    resizeWorld();
+}
+
+void Field::resizeWorld()
+{
+    settings_.recomputeDerived();
+    settings_.recenterSpawns();
+    for (Creature& c : creatures_)
+        c.confineTo(settings_);
+    if (cell_size_ > 0.0f)
+        setCellSize(cell_size_); // same cells, as many as the new bounds need
+    neighbor_lists_.invalidate();
+    layoutGrass();
+}
+
+void Field::Reconfigure(const Settings& settings)
+{
+    const Settings old = settings_;
+    settings_ = settings;
+    settings_.recomputeDerived();
+    
+    const bool bounds = old.x_min != settings_.x_min || old.x_max != settings_.x_max
+                     || old.y_min != settings_.y_min || old.y_max != settings_.y_max;
+    if (bounds)
+    {
+        for (Creature& c : creatures_)
+            c.confineTo(settings_);
+    }
+    
+    // A retuned grid keeps its cell size; otherwise follow the radii.
+    const float cell_size = (settings_.auto_cell_size && cell_size_ > 0.0f) ? cell_size_ : settings_.cell_size;
+    if (bounds || cell_size != cell_size_ || old.sparse_grid != settings_.sparse_grid)
+        setCellSize(cell_size);
+    
+    // Changing grass kind or layout starts it over; new bounds only move it.
+    if (old.grass_raster != settings_.grass_raster || old.grass_patch_rows != settings_.grass_patch_rows
+        || old.grass_patch_cols != settings_.grass_patch_cols
+        || old.grass_raster_subdivisions != settings_.grass_raster_subdivisions)
+    {
+        initializeGrass();
+        std::fill(slot_intents_.begin(), slot_intents_.end(), SteeringIntent{}); // grass targets are indices
+        cells_dirty_ = true;
+    }
+    else if (bounds)
+    {
+        layoutGrass();
+    }
+    
+    // Switching timers on, or changing their resolution, starts everyone's
+    // clocks from now; the accumulators pick up where they were.
+    if (settings_.event_timers != old.event_timers || settings_.timer_resolution != old.timer_resolution)
+    {
+        timers_.reset(timerTick(sim_time_));
+        if (settings_.event_timers)
+        {
+            for (std::size_t i = 0; i < creatures_.size(); ++i)
+            {
+                if (creatures_[i].isAlive() && !creatures_[i].isGhost())
+                    scheduleTimers(creatures_.handleAt(i));
+            }
+        }
+    }
+    
+    configureWorkers();
+    neighbor_lists_.invalidate();
+}
+
+void Field::layoutGrass()
+{
+    // Grass keeps its health and is laid out over the new bounds.
+    if (!grass_raster_.empty())
+    {
+        grass_raster_.reshape(settings_.x_min, settings_.y_min, settings_.x_max - settings_.x_min,
+                              settings_.y_max - settings_.y_min, settings_.grass_max_health);
+        std::fill(slot_intents_.begin(), slot_intents_.end(), SteeringIntent{}); // cell indices moved
+    }
+    else if (!grassPatches_.empty())
+    {
+        std::vector<float> health;
+        health.reserve(grassPatches_.size());
+        for (const GrassPatch& g : grassPatches_)
+            health.push_back(g.health);
+        initializeGrass();
+        if (health.size() == grassPatches_.size())
+        {
+            for (std::size_t i = 0; i < health.size(); ++i)
+                grassPatches_[i].health = health[i];
+        }
+    }
+    cells_dirty_ = true;
 }
 
 void Field::SetPreyMaxAge(float age)
@@ -445,9 +1514,9 @@ template <typename T> void Field::ComputeCellLocation(const T& obj, int *cx, int
     
     float x_min = settings_.x_min;
     float y_min = settings_.y_min;
-    float cell_size = settings_.cell_size;
-    int num_cells_x = settings_.num_cells_x;
-    int num_cells_y = settings_.num_cells_y;
+    float cell_size = cell_size_;
+    int num_cells_x = num_cells_x_;
+    int num_cells_y = num_cells_y_;
     
     
     int cx_unclamped = std::floor((world_x - x_min)/cell_size);
@@ -463,48 +1532,248 @@ void GrassPatch::setCellLocation(float cx, float cy)
     cell_y_ = cy;
 }
 
+void Field::schedulePerception(uint8_t* perceive)
+{
+    const std::size_t n = creatures_.size();
+    const std::size_t slots = creatures_.slotCount();
+    if (slot_intents_.size() < slots)
+    {
+        slot_intents_.resize(slots);
+        slot_intent_owner_.resize(slots);
+    }
+    
+    const int interval = std::max(settings_.perception_interval_steps, 1);
+    const std::size_t budget = static_cast<std::size_t>(std::max(settings_.perception_budget, 0));
+    
+    // Budget mode: the next `budget` creatures in dense order, wrapping.
+    const std::size_t start = n > 0 ? perception_cursor_ % n : 0;
+    if (budget > 0 && n > 0)
+        perception_cursor_ = (start + budget) % n;
+    
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        const SlotHandle h = creatures_.handleAt(i);
+        bool due;
+        if (slot_intent_owner_[h.index] != h)
+            due = true; // never perceived: newborn, or a reused slot
+        else if (budget > 0)
+            due = (i + n - start) % n < budget;
+        else
+            due = (step_count_ + h.index) % interval == 0; // staggered by id
+        if (slot_intent_owner_[h.index] != h)
+        {
+            slot_intent_owner_[h.index] = h;
+            slot_intents_[h.index] = {}; // don't inherit the last occupant's target
+        }
+        perceive[i] = due;
+    }
+}
+
+// Would male-seeking A chase B as a mate? Same test the full search uses.
+bool Field::isMateCandidate(Creature& A, Creature& B)
+{
+    return withSpecies(A.species(), [&](auto policy) { return isMateCandidateAs<decltype(policy)>(A, B); });
+}
+
+template <typename Policy>
+bool Field::isMateCandidateAs(const Creature& A, const Creature& B) const
+{
+    if (settings_.prevent_spirals && A.sex() != Sex::Male) return false; // only males pursue; removes spiral chases
+    if (B.species() != Policy::role) return false;
+    if (B.libido() < Policy::libidoThreshold(settings_)) return false; // only pursue females who are ready to go
+    // effectively, male A's only chase female B's for mating, both must be "full enough"
+    return B.sex() == Sex::Female
+        && 0.5*(A.normalizedHunger()+B.normalizedHunger()) >= settings_.min_normalized_hunger_to_mate;
+}
+
+// Re-check the target remembered in `intent` and re-aim at it. False if
+// it's gone, out of sight, or no longer what A is after; the caller then
+// searches from scratch.
+bool Field::trackTarget(Creature& A, SteeringIntent& intent)
+{
+    const float visionR = (A.species() == SpeciesRole::Predator)
+    ? settings_.predator_vision_radius
+    : settings_.prey_vision_radius;
+    
+    Vec2 target;
+    if (intent.target_kind == TargetKind::Grass)
+    {
+        if (A.species() != SpeciesRole::Prey || !A.shouldHunt(settings_)) return false;
+        if (intent.target_id >= grassPatches_.size()) return false;
+        const GrassPatch& g = grassPatches_[intent.target_id];
+        if (g.health <= 0.0f) return false;
+        target = g.center;
+    }
+    else if (intent.target_kind == TargetKind::GrassCell)
+    {
+        if (A.species() != SpeciesRole::Prey || !A.shouldHunt(settings_)) return false;
+        if (intent.target_id >= grass_raster_.size()) return false;
+        if (grass_raster_.health(intent.target_id) <= std::max(settings_.min_grass_edible_health, 0.0f)) return false;
+        target = grass_raster_.center(intent.target_id);
+    }
+    else if (intent.target_kind == TargetKind::Creature)
+    {
+        // Hungry prey would rather look for grass than keep courting.
+        if (A.shouldHunt(settings_) || !A.shouldSeekMate(settings_)) return false;
+        Creature* B = creatures_.get(SlotHandle::fromPacked(intent.target_id));
+        if (!B || !B->isAlive() || !isMateCandidate(A, *B)) return false;
+        target = B->position();
+    }
+    else return false;
+    
+    const float d2 = distanceSquared(A.position(), target);
+    if (d2 >= visionR * visionR || d2 <= 0.0f) return false;
+    const Vec2 dir = target - A.position();
+    intent.desired_dir = 1.f/std::sqrt(d2) * dir;
+    intent.has_target = true;
+    return true;
+}
+
 void Field::computeIntents()
 {
     intents_.assign(creatures_.size(), {});
+    const bool use_lists = settings_.neighbor_lists && neighbor_lists_.built();
+    
+    // Pick who re-perceives this step; everyone else keeps last time's
+    // intent, carried per slot so it survives erases and reorders.
+    std::pmr::vector<uint8_t> perceive(creatures_.size(), &frame_arena_);
+    schedulePerception(perceive.data());
+    
+    const int refresh = std::max(settings_.target_refresh_steps, 1);
     
-    for (int i = 0; i < (int) creatures_.size(); ++i)
+    // Each creature's intent depends only on the state before the phase,
+    // so tiles can run in any order on any thread.
+    if (scheduler_ && !cells_dirty_)
     {
-        Creature& A = creatures_[i];
-        if (!A.isAlive()) continue; // he's DEAD! he's LIFELESS!
-        
-        const float visionR = (A.species() == SpeciesRole::Predator)
-        ? settings_.predator_vision_radius
-        : settings_.prey_vision_radius;
-        const float visionR2 = visionR * visionR;
-        const int maxOffset = (int) std::ceil(visionR / settings_.cell_size);
-        
-        int cx, cy;
-        ComputeCellLocation<Creature>(A, &cx, &cy);
-        
-        int bestIdx = -1;
-        float bestD2 = visionR2;
+        buildTiles();
+        scheduler_->run(tile_weights_, [&](std::size_t t, int)
+        {
+            for (uint32_t k = tile_starts_[t]; k < tile_starts_[t + 1]; ++k)
+                computeIntent(tile_items_[k], perceive[tile_items_[k]], use_lists, refresh);
+        }, settings_.numa_tiles ? &tile_homes_ : nullptr);
+        addNodeLoad();
+        // The dead aren't in the grid.
+        for (int i = 0; i < (int) creatures_.size(); ++i)
+        {
+            if (!creatures_[i].isAlive())
+                computeIntent(i, perceive[i], use_lists, refresh);
+        }
+    }
+    else
+    {
+        for (int i = 0; i < (int) creatures_.size(); ++i)
+            computeIntent(i, perceive[i], use_lists, refresh);
+    }
+    
+    // Copy back everything, tracked and re-perceived alike; for the rest
+    // it's a no-op.
+    for (std::size_t i = 0; i < creatures_.size(); ++i)
+        slot_intents_[creatures_.handleAt(i).index] = intents_[i];
+}
+
+void Field::computeIntent(int i, bool due, bool use_lists, int refresh)
+{
+    const SlotHandle self = creatures_.handleAt(i);
+    const SteeringIntent& last = slot_intents_[self.index];
+    Creature& A = creatures_[i];
+    if (A.isGhost()) return; // steered by its owner
+    
+    // A creature with a target just re-aims at it, every step, until
+    // it's lost or the periodic refresh comes round.
+    if (settings_.target_tracking && last.target_kind != TargetKind::None
+        && (step_count_ + self.index) % refresh != 0 && A.isAlive())
+    {
+        SteeringIntent tracked = last;
+        if (trackTarget(A, tracked))
+        {
+            intents_[i] = tracked;
+            return;
+        }
+    }
+    else if (!due)
+    {
+        intents_[i] = last;
+        return;
+    }
+    
+    if (!A.isAlive()) return; // he's DEAD! he's LIFELESS!
+    
+    withSpecies(A.species(), [&](auto policy) { perceiveAs<decltype(policy)>(i, use_lists); });
+}
+
+// The full search for creature i's target, specialized by species.
+template <typename Policy>
+void Field::perceiveAs(int i, bool use_lists)
+{
+    const SlotHandle self = creatures_.handleAt(i);
+    Creature& A = creatures_[i];
+    
+    const float visionR = Policy::visionRadius(settings_);
+    const float visionR2 = visionR * visionR;
+    const int maxOffset = (int) std::ceil(visionR / cell_size_);
+    
+    // What A is after can't change during the search. Hungry creatures
+    // only ever look for grass (predators find prey by contact), so only
+    // a creature in the mood scans the others at all.
+    const bool hungry = A.hunger() <= Policy::hungerThreshold(settings_);
+    const bool wants_grass = Policy::grazes && hungry;
+    const bool wants_mate = !hungry && A.libido() >= Policy::libidoThreshold(settings_);
+    
+    int cx, cy;
+    ComputeCellLocation<Creature>(A, &cx, &cy);
+    
+    int bestIdx = -1;
+    float bestD2 = visionR2;
+    
+    // NEW for grass grid
+    int bestGrassIdx = -1;
+    float bestGrassD2 = visionR2;
+    
+    auto considerCreature = [&](int idx)
+    {
+        if (idx < 0) return; // died since the lists were built
+        if (idx == i) return;
+        Creature& B = creatures_[idx];
+        if(!B.isAlive()) return;
         
-        // NEW for grass grid
-        int bestGrassIdx = -1;
-        float bestGrassD2 = visionR2;
+        const float d2 = distanceSquared(A.position(), B.position());
+        if (d2 >= bestD2) return;
+        if (d2 <= 0.0f) return; // same spot (say, both pushed into a corner): no way to steer
         
-        // neighboring cell loops
-        for(int dx = -maxOffset; dx <= maxOffset; ++dx)
+        if (isMateCandidateAs<Policy>(A, B))
         {
-            for(int dy = -maxOffset; dy <= maxOffset; ++dy)
+            bestIdx = idx;
+            bestD2 = d2;
+        }
+    };
+    
+    // With a current neighbor list the cells are only needed for grass.
+    const bool use_list = use_lists && neighbor_lists_.hasList(self);
+    const bool raster = !grass_raster_.empty();
+    const bool scan_cells = (wants_grass && !raster) || (wants_mate && !use_list);
+    const int cellOffset = scan_cells ? maxOffset : -1;
+    
+    // neighboring cell loops
+    for(int dx = -cellOffset; dx <= cellOffset; ++dx)
+    {
+        for(int dy = -cellOffset; dy <= cellOffset; ++dy)
+        {
+            int nx = cx + dx;
+            int ny = cy + dy;
+            
+            // bounds checking
+            if (nx < 0 || nx >= num_cells_x_) continue;
+            if (ny < 0 || ny >= num_cells_y_) continue;
+            
+            const FieldCell* found = grid_.find(nx, ny);
+            if (!found) continue; // empty sparse cell
+            const FieldCell& cell = *found;
+            
+            // Prey Seeks Grass
+            // This relies on grass being assigned to cells before computeIntents()
+            if constexpr (Policy::grazes)
             {
-                int nx = cx + dx;
-                int ny = cy + dy;
-                
-                // bounds checking
-                if (nx < 0 || nx >= settings_.num_cells_x) continue;
-                if (ny < 0 || ny >= settings_.num_cells_y) continue;
-                
-                FieldCell& cell = field_cells_[nx][ny];
-                
-                // Prey Seeks Grass
-                // This relies on grass being assigned to cells before computeIntents()
-                if (A.species() == SpeciesRole::Prey && A.shouldHunt(settings_))
+                if (wants_grass && !raster)
                 {
                     for (int gi : cell.cell_grassPatches_indices)
                     {
@@ -519,64 +1788,79 @@ void Field::computeIntents()
                         }
                     }
                 }
-                
+            }
+            
+            if (wants_mate && !use_list)
+            {
                 for (int idx : cell.cell_creatures_indices)
+                    considerCreature(idx);
+            }
+        }
+    } // end neighbor groups
+    
+    // Raster grass: each block's healthiest cell stands in for the block.
+    int bestGrassCell = -1;
+    if constexpr (Policy::grazes)
+    {
+        if (wants_grass && raster)
+        {
+            int bx, by;
+            grass_raster_.blockAt(A.position(), &bx, &by);
+            const int reach = (int) std::ceil(visionR / grass_raster_.blockSize());
+            const int bx0 = std::max(bx - reach, 0), bx1 = std::min(bx + reach, grass_raster_.blockCols() - 1);
+            const int by0 = std::max(by - reach, 0), by1 = std::min(by + reach, grass_raster_.blockRows() - 1);
+            for (int y = by0; y <= by1; ++y)
+            {
+                for (int x = bx0; x <= bx1; ++x)
                 {
-                    if (idx == i) continue;
-                    Creature& B = creatures_[idx];
-                    if(!B.isAlive()) continue;
-                    
-                    const float d2 = distanceSquared(A.position(), B.position());
-                    if (d2 >= bestD2) continue;
-                    
-                    // Decide what A is looking for
-                    if (A.shouldHunt(settings_))
+                    const int gc = grass_raster_.bestInBlock(x, y);
+                    if (gc < 0) continue;
+                    const float d2g = distanceSquared(A.position(), grass_raster_.center(gc));
+                    if (d2g < bestGrassD2)
                     {
-//                        if (A.species() == SpeciesRole::Predator && B.species() == SpeciesRole::Prey)
-//                        {
-//                            bestIdx = idx;
-//                            bestD2 = d2;
-//                        }
-                    } else if (A.shouldSeekMate(settings_))
-                    {
-                        if (settings_.prevent_spirals && A.sex() != Sex::Male) continue; // only males pursue; removes spiral chases
-                        if (!B.shouldSeekMate(settings_)) continue; // only pursue females who are ready to go
-//                        if (A.species() == B.species())
-//                        {
-//                            const bool compatible = (A.sex() == Sex::Female && B.sex() == Sex::Male) ||
-//                            (A.sex() == Sex::Male && B.sex() == Sex::Female);
-//                            if (compatible)
-//                            {
-//                                bestIdx = idx;
-//                                bestD2 = d2;
-//                            }
-//                        }
-                        // effectively, male A's only chase female B's for mating, both must be "full enough"
-                        if (A.species() == B.species() && B.sex() == Sex::Female
-                            && 0.5*(A.normalizedHunger()+B.normalizedHunger()) >= settings_.min_normalized_hunger_to_mate)
-                        {
-                            bestIdx = idx;
-                            bestD2 = d2;
-                        }
+                        bestGrassD2 = d2g;
+                        bestGrassCell = gc;
                     }
                 }
             }
-        } // end neighbor groups
-        
-        // If hungry prey found grass, prefer that over mate seeking
-        if (A.species() == SpeciesRole::Prey && A.shouldHunt(settings_) && bestGrassIdx != -1)
-        {
-            Vec2 dir = grassPatches_[bestGrassIdx].center - A.position();
-            intents_[i].desired_dir = 1.f/std::sqrt(lengthSquared(dir)) * dir;
-            intents_[i].has_target = true;
-            continue; // don't target a mate too
-        }
-        
-        if (bestIdx != -1)
-        {
-            Vec2 dir = creatures_[bestIdx].position() - A.position();
-            intents_[i].desired_dir = 1.f/std::sqrt(lengthSquared(dir)) * dir;
-            intents_[i].has_target = true;
         }
     }
+    
+    if (wants_mate && use_list)
+    {
+        for (SlotHandle h : neighbor_lists_.list(self))
+            considerCreature(creatures_.denseIndex(h));
+        for (SlotHandle h : neighbor_lists_.pending())
+            considerCreature(creatures_.denseIndex(h));
+    }
+    
+    // If hungry prey found grass, prefer that over mate seeking
+    if (wants_grass && bestGrassIdx != -1)
+    {
+        Vec2 dir = grassPatches_[bestGrassIdx].center - A.position();
+        intents_[i].desired_dir = 1.f/std::sqrt(lengthSquared(dir)) * dir;
+        intents_[i].has_target = true;
+        intents_[i].target_kind = TargetKind::Grass;
+        intents_[i].target_id = static_cast<uint32_t>(bestGrassIdx);
+        return; // don't target a mate too
+    }
+    if (bestGrassCell != -1)
+    {
+        Vec2 dir = grass_raster_.center(bestGrassCell) - A.position();
+        const float d2 = lengthSquared(dir);
+        intents_[i].desired_dir = d2 > 0.0f ? 1.f/std::sqrt(d2) * dir : Vec2{};
+        intents_[i].has_target = true;
+        intents_[i].target_kind = TargetKind::GrassCell;
+        intents_[i].target_id = static_cast<uint32_t>(bestGrassCell);
+        return;
+    }
+    
+    if (bestIdx != -1)
+    {
+        Vec2 dir = creatures_[bestIdx].position() - A.position();
+        intents_[i].desired_dir = 1.f/std::sqrt(lengthSquared(dir)) * dir;
+        intents_[i].has_target = true;
+        intents_[i].target_kind = TargetKind::Creature;
+        intents_[i].target_id = creatures_[bestIdx].id();
+    }
 }
@@ -16,10 +16,21 @@
 #include <random>
 #include <chrono>
 #include <iostream>
+#include <memory>
 
 #include "constants.hpp"
 #include "settings.hpp"
 #include "creature.hpp"
+#include "frame_arena.hpp"
+#include "slot_map.hpp"
+#include "field_events.hpp"
+#include "random_streams.hpp"
+#include "neighbor_lists.hpp"
+#include "timing_wheel.hpp"
+#include "cell_grid.hpp"
+#include "function_ref.hpp"
+#include "tile_scheduler.hpp"
+#include "grass_raster.hpp"
 
 
 // POD snapshot used for bridging out to Swift / C++.
@@ -61,10 +72,13 @@ struct GrassPatch
     int cell_x_, cell_y_;  // may not use
 };
 
-struct FieldCell
+// One heatmap bin: counts plus means over the creatures inside it.
+struct HeatmapBin
 {
-    std::vector<int> cell_creatures_indices;
-    std::vector<int> cell_grassPatches_indices;
+    float prey = 0.0f;
+    float predators = 0.0f;
+    float mean_hunger = 0.0f;
+    float mean_age = 0.0f;
 };
 
 struct CreatureState
@@ -77,6 +91,16 @@ struct CreatureState
 };
 
 
+// Something that happened to a ghost during a step, to be carried back
+// to the subdomain that owns the real creature.
+enum class GhostEffectType : uint8_t { Eaten, Fed, Mated };
+
+struct GhostEffect
+{
+    SlotHandle ghost;
+    GhostEffectType type;
+};
+
 enum class IntentType { None, Hunt, SeekMate, SeekFood };
 enum class DistType { Uniform, Normal };
 
@@ -88,11 +112,54 @@ struct Perception
     Vec2 mateDirection{};
 };
 
+// Everything step() carries from one step to the next. The grid, intents
+// and per-step scratch are rebuilt from this, so restoring a keyframe and
+// replaying the same dts reproduces the original run exactly.
+struct FieldKeyframe
+{
+    SlotMap<Creature> creatures;
+    std::vector<GrassPatch> grass;
+    std::vector<float> grass_raster; // cell health, with Settings::grass_raster
+    RandomStream spawn_random;
+    RandomStream wander_random;
+    uint64_t seed = 0;
+    double sim_time = 0.0;
+    uint64_t step_count = 0;
+    float cell_size = 0.0f;
+    std::vector<SteeringIntent> slot_intents;
+    std::vector<SlotHandle> slot_intent_owner;
+    std::size_t perception_cursor = 0;
+    FieldTallies tallies;
+    // When the lists were built decides pair order until the next
+    // rebuild, so a replay has to start from the same lists.
+    NeighborLists neighbor_lists;
+
+    std::size_t bytes() const noexcept
+    {
+        return sizeof(*this) + creatures.bytes() + grass.capacity() * sizeof(GrassPatch)
+             + grass_raster.capacity() * sizeof(float)
+             + slot_intents.capacity() * sizeof(SteeringIntent)
+             + slot_intent_owner.capacity() * sizeof(SlotHandle)
+             + neighbor_lists.bytes();
+    }
+};
+
 class Field
 {
 public:
     explicit Field(const Settings& settings);
     void ResetFromSettings();
+    // ResetFromSettings() without the console output. Creature storage,
+    // grid cells, timer slots and grass keep the capacity they have, so
+    // back-to-back runs of the same size don't allocate.
+    void WarmReset();
+    
+    // Take on new settings mid-run, keeping the population. Derived
+    // settings, the grid, grass layout, timers and workers are rebuilt
+    // only as far as what changed requires; creatures already alive keep
+    // the per-species rates they were born with, and the random streams
+    // carry on (a new rng_seed applies from the next reset).
+    void Reconfigure(const Settings& settings);
     // Advance the simulation by dt seconds.
     void step(float dt);
     
@@ -101,18 +168,97 @@ public:
     std::vector<CreatureState> snapshot() const;
     
     const Settings&                            settings()  const noexcept { return settings_;  }
-    const std::vector<Creature>&               creatures() const noexcept { return creatures_; }
+    const std::vector<Creature>&               creatures() const noexcept { return creatures_.values(); }
     const std::vector<GrassPatch>&             grassPatches() const noexcept { return grassPatches_; }
-    const std::vector<std::vector<FieldCell>>& field_cells() const noexcept { return field_cells_; }
+    const GrassRaster&                         grassRaster() const noexcept { return grass_raster_; } // empty unless settings.grass_raster
+    const CellGrid&                            grid() const noexcept { return grid_; }
     const int elapsedSimSeconds() const noexcept { return elapsed_sim_seconds_; }
     const int pairChecksPerFrame() const noexcept { return pair_checks_per_frame_; }
     const float framesPerSecond() const noexcept { return 1.0f / elapsed_sec_; }
     
+    // O(1) lookup by Creature::id(); ids are generational handles, so a
+    // creature that has died (or whose slot was reused) returns nullptr.
+    const Creature* findCreature(uint32_t id) const noexcept { return creatures_.get(SlotHandle::fromPacked(id)); }
+    
+    // Life-cycle event stream. Off until enabled; once on, step() pushes
+    // Born/Eaten/Starved/DiedOfAge/Mated events without ever blocking, and
+    // a single consumer thread may hold the queue and drain it.
+    void EnableEvents(std::size_t capacity);
+    void DisableEvents() { events_.reset(); }
+    std::shared_ptr<FieldEventQueue> eventQueue() const noexcept { return events_; }
+    double simTime() const noexcept { return sim_time_; }
+    uint64_t stepCount() const noexcept { return step_count_; }
+    const FieldTallies& tallies() const noexcept { return tallies_; }
+    void populationCounts(int* prey, int* predators) const;
+    
+    // Skip `seconds` of simulated time in one go and replace the population
+    // with `prey` and `predators` creatures resampled from the current one:
+    // each copies the state of a random living member of its species and
+    // lands near it, so the spatial distribution and the age / hunger mix
+    // carry over. Used to resume agents after a mean-field fast-forward.
+    // No events are emitted.
+    void jumpAhead(double seconds, int prey, int predators);
+
+    // Domain decomposition (see domain.hpp). adoptCreature() inserts a
+    // copy of a creature from another subdomain under a new local id:
+    // either a migrant that this Field now owns, timers and all, or a
+    // ghost. Ghosts are perceived and interacted with but never updated,
+    // graze nothing, emit no events and aren't counted; whatever happens
+    // to them during a step is queued in ghostEffects() for the owner to
+    // apply with applyGhostEffect().
+    SlotHandle adoptCreature(const Creature& state, GhostKind kind);
+    bool releaseCreature(SlotHandle handle);
+    void removeGhosts();
+    const std::vector<GhostEffect>& ghostEffects() const noexcept { return ghost_effects_; }
+    void clearGhostEffects() { ghost_effects_.clear(); }
+    bool applyGhostEffect(SlotHandle owned, GhostEffectType type);
+
+    // Keep only the grass patches for which keep(patch) is true.
+    template <typename Keep>
+    void retainGrass(Keep&& keep)
+    {
+        std::erase_if(grassPatches_, [&](const GrassPatch& g) { return !keep(g); });
+        std::fill(slot_intents_.begin(), slot_intents_.end(), SteeringIntent{}); // grass targets are indices
+        cells_dirty_ = true;
+    }
+
+    // Rewind support. captureKeyframe() copies into `out`, reusing its
+    // buffers; restoreKeyframe() replays nothing by itself, it just puts
+    // the Field back. Muting keeps replayed steps off the event stream.
+    void captureKeyframe(FieldKeyframe& out) const;
+    void restoreKeyframe(const FieldKeyframe& keyframe);
+    void setEventsMuted(bool muted) noexcept { events_muted_ = muted; }
+    bool eventsMuted() const noexcept { return events_muted_; }
+
+    // Spatial queries answered from the grid, which is rebuilt at the end
+    // of every step: cost scales with the cells the rectangle covers, not
+    // with the population. Fill `out` with dense indices into creatures()
+    // / grassPatches(); a patch counts if its disk touches the rectangle.
+    void queryCreaturesInRect(float x0, float y0, float x1, float y1, std::vector<int>& out) const;
+    void queryGrassInRect(float x0, float y0, float x1, float y1, std::vector<int>& out) const;
+    
+    // Density heatmap over the whole world, row-major (y outer), built from
+    // the per-cell stats gathered during the grid rebuild. Resolution is
+    // capped at the grid's; coarser requests merge neighboring cells.
+    void densityHeatmap(int width, int height, std::vector<HeatmapBin>& out) const;
+    
+    // Work per NUMA node (or one entry for the whole pool) over the last
+    // step's parallel phases; empty when running single-threaded.
+    const std::vector<NodeLoad>& nodeLoad() const noexcept { return node_load_; }
+    
+    // Current grid geometry. Starts at Settings::cell_size; with
+    // auto_cell_size it is retuned as the population changes.
+    float cellSize() const noexcept { return cell_size_; }
+    int numCellsX() const noexcept { return num_cells_x_; }
+    int numCellsY() const noexcept { return num_cells_y_; }
+    
     // Public settings-setters (lol that won't confuse anyone)
     void SetNumPrey(int);
     void SetNumPred(int);
     void SetPreyMaxAge(float);
     void SetPredMaxAge(float);
+    // Live resizes: the grid, grass and spawn distributions follow the
+    // new bounds and creatures outside them are pushed back in.
     void SetFieldDimensions(float, float);
     void SetFieldWidth(float);
     void SetFieldHeight(float);
@@ -120,37 +266,125 @@ public:
     
 private:
     Settings settings_;
-    uint32_t next_creature_id = 1; // monotonic counter to prevent indexing sync issues
     
-    std::vector<Creature> creatures_;
+    // Stable generational handles; a creature's id() is its packed handle.
+    SlotMap<Creature> creatures_;
     std::vector<GrassPatch> grassPatches_;
-    std::vector<std::vector<FieldCell>> field_cells_;
-    std::vector<SteeringIntent> intents_;
-    std::mt19937 rng_;
-    
-    std::uniform_real_distribution<float> x_dist_uniform_;
-    std::uniform_real_distribution<float> y_dist_uniform_;
-    std::uniform_real_distribution<float> v_dist_uniform_;
-    std::normal_distribution<float> x_prey_spawn_normal_;
-    std::normal_distribution<float> y_prey_spawn_normal_;
-    std::normal_distribution<float> x_predator_spawn_normal_;
-    std::normal_distribution<float> y_predator_spawn_normal_;
-    std::bernoulli_distribution prey_female_dist_;
-    std::bernoulli_distribution pred_female_dist_;
+    GrassRaster grass_raster_; // replaces the patches with settings_.grass_raster
+    CellGrid grid_; // dense or sparse per settings_.sparse_grid
+    std::vector<SteeringIntent> intents_;           // dense, what the update reads this step
+    std::vector<SteeringIntent> slot_intents_;      // by slot: last perceived intent
+    std::vector<SlotHandle>     slot_intent_owner_; // by slot: whose intent it is
+    std::size_t perception_cursor_ = 0;             // round-robin position for perception_budget
+    NeighborLists neighbor_lists_; // only maintained with settings_.neighbor_lists
+    
+    // Parallel phases (settings_.worker_threads > 1). Perception runs over
+    // the grid in occupancy-weighted tiles: tile t is the creatures
+    // tile_items_[tile_starts_[t], tile_starts_[t + 1]).
+    std::shared_ptr<TileScheduler> scheduler_; // shared by copies of this Field
+    std::vector<int> tile_items_;
+    std::vector<uint32_t> tile_starts_;
+    std::vector<uint32_t> tile_weights_;
+    std::vector<uint16_t> tile_homes_; // numa_tiles: each tile's node
+    std::vector<uint32_t> range_weights_; // parallelRanges(): all 1
+    std::vector<uint16_t> range_homes_;
+    std::vector<NodeLoad> node_load_;
+    
+    // Per-creature timers for settings_.event_timers. Entries go stale
+    // when their creature dies and are dropped when they fire.
+    enum class CreatureTimer : uint8_t { Hunger, Accel, Death };
+    struct TimerEntry
+    {
+        SlotHandle handle;
+        CreatureTimer kind;
+    };
+    TimingWheel<TimerEntry> timers_;
+    FrameArena frame_arena_; // per-step scratch, reset at the end of step()
+    
+    // Counter-based streams, all derived from one seed so a seeded run is
+    // reproducible. Spawning (positions, velocities, sex, creature rolls)
+    // and wandering draw from separate streams.
+    uint64_t seed_ = 0;
+    RandomStream spawn_random_;
+    RandomStream wander_random_;
 
+    // Offspring staged during handleInteractions and spawned once the
+    // pair loop is done, so they get their handle on insertion.
+    struct Birth
+    {
+        SpeciesRole species;
+        Sex sex;
+        Vec2 position;
+        Vec2 velocity;
+        float hunger;
+        CreatureRolls rolls;
+        uint32_t parent_a;
+        uint32_t parent_b;
+    };
+    
+    void spawnCreature(SpeciesRole, Sex, const Vec2&, const Vec2&, const CreatureRolls&,
+                       uint32_t parent_a = 0, uint32_t parent_b = 0);
+    void spawnPopulation(SpeciesRole, int count, DistType);
+    void reset(bool verbose);
+    void resizeWorld();
+    void layoutGrass();
+    void seedRandomStreams();
+    void emitEvent(FieldEventType, const Creature& subject, uint32_t other = 0, uint32_t other2 = 0);
+    void removeDeadCreatures();
+    void reorderCreatures();
+    void rebuildCells();
+    void setCellSize(float);
+    void retuneGrid();
+    void refreshNeighborLists();
+    float maxNeighborListDisplacement() const;
+    uint32_t timerTick(double seconds) const;
+    uint32_t timerPeriod(float seconds) const;
+    void scheduleTimers(SlotHandle);
+    void enqueueTimers(SlotHandle);
+    void rebuildTimers();
+    void fireTimers();
+    void cellRange(float x0, float y0, float x1, float y1, int* cx0, int* cy0, int* cx1, int* cy1) const;
     void initializeFieldCells();
     void initializeCreatures(DistType);
     void handleGrass(float dt);
-    void handleInteractions();
+    void handleGrassRaster(float dt);
+    void handleInteractions(const Vec2* start_positions); // null: end-of-step positions only
     void initializeGrass();
     void pairCheck();
     void computeIntents();
+    void computeIntent(int i, bool due, bool use_lists, int refresh);
+    void configureWorkers();
+    void buildTiles();
+    int homeNode(int cx) const;
+    void addNodeLoad();
+    void placeCreaturePages(const uint32_t* node_starts, int nodes);
+    void parallelRanges(std::size_t n, std::size_t grain, FunctionRef<void(std::size_t, std::size_t)> fn);
+    void schedulePerception(uint8_t* perceive);
+    bool isMateCandidate(Creature& A, Creature& B);
+    // Species-specialized perception, Policy being a SpeciesPolicy<R>.
+    template <typename Policy> void perceiveAs(int i, bool use_lists);
+    template <typename Policy> bool isMateCandidateAs(const Creature& A, const Creature& B) const;
+    bool trackTarget(Creature& A, SteeringIntent& intent);
     template <typename T> void ComputeCellLocation(const T&, int*, int*);
     
+    // Grid geometry, owned here rather than in Settings so it can change
+    // at runtime (see retuneGrid()).
+    float cell_size_ = 0.0f;
+    int num_cells_x_ = 0;
+    int num_cells_y_ = 0;
+    
     // recalculated after determining # of cells
     int actual_cell_width_;
     int actual_cell_height_;
     
+    std::shared_ptr<FieldEventQueue> events_; // shared by copies of this Field
+    bool events_muted_ = false;
+    FieldTallies tallies_;
+    std::vector<GhostEffect> ghost_effects_; // this step's, see adoptCreature()
+
+    double sim_time_ = 0.0;
+    uint64_t step_count_ = 0;
+    bool cells_dirty_ = true; // grid doesn't reflect creatures_ yet
     int elapsed_sim_seconds_ = 0;
     int pair_checks_per_frame_ = 0;
     
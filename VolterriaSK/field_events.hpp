@@ -0,0 +1,54 @@
+//
+//  field_events.hpp
+//  Volterria
+//
+//  Created by Devin R Cohen on 10/18/26.
+//
+
+#pragma once
+
+// Typed life-cycle events emitted by the Field while it steps.
+// Consumers drain them from a lock-free queue instead of diffing
+// snapshots to find out who was born, eaten or died.
+
+#include <cstdint>
+
+#include "creature.hpp"
+#include "spsc_queue.hpp"
+
+enum class FieldEventType : int
+{
+    Born      = 0, // subject = newborn, other/other2 = parents (0 for initial spawns)
+    Eaten     = 1, // subject = prey, other = predator
+    Starved   = 2, // subject = the creature that starved
+    DiedOfAge = 3, // subject = the creature that reached max age
+    Mated     = 4, // subject/other = the two parents
+};
+
+struct FieldEvent
+{
+    FieldEventType type = FieldEventType::Born;
+    uint32_t    subject = 0; // Creature::id()
+    uint32_t    other   = 0;
+    uint32_t    other2  = 0;
+    SpeciesRole species = SpeciesRole::Prey;
+    float       x = 0.0f;
+    float       y = 0.0f;
+    float       time = 0.0f; // sim seconds
+};
+
+using FieldEventQueue = SpscQueue<FieldEvent>;
+
+// Running totals of every event the Field has emitted since the last
+// reset, by type and species, whether or not a queue is attached. The
+// difference of two tallies gives the event counts over a window.
+struct FieldTallies
+{
+    static constexpr int kTypes = 5;
+    uint64_t counts[kTypes][2] = {}; // [FieldEventType][SpeciesRole]
+
+    uint64_t count(FieldEventType type, SpeciesRole species) const noexcept
+    {
+        return counts[static_cast<int>(type)][static_cast<int>(species)];
+    }
+};
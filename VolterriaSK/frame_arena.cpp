@@ -0,0 +1,86 @@
+//
+//  frame_arena.cpp
+//  Volterria
+//
+//  Created by Devin R Cohen on 10/18/26.
+//
+
+#include "frame_arena.hpp"
+
+#include <algorithm>
+#include <memory>
+#include <new>
+
+FrameArena::FrameArena(std::size_t initial_bytes)
+    : buffer_(initial_bytes)
+{
+}
+
+FrameArena::~FrameArena()
+{
+    releaseOverflow();
+}
+
+FrameArena::FrameArena(const FrameArena& other)
+    : std::pmr::memory_resource(),
+      buffer_(other.buffer_.size())
+{
+}
+
+FrameArena& FrameArena::operator=(const FrameArena& other)
+{
+    if (this == &other) return *this;
+    releaseOverflow();
+    offset_ = 0;
+    buffer_.assign(other.buffer_.size(), std::byte{0});
+    return *this;
+}
+
+void FrameArena::reset()
+{
+    const std::size_t used = offset_ + overflow_bytes_;
+    high_water_ = std::max(high_water_, used);
+
+    // Spilled last step: grow once so the same demand fits next time.
+    if (overflow_bytes_ > 0)
+    {
+        releaseOverflow();
+        buffer_.assign(used + used / 2, std::byte{0});
+    }
+    offset_ = 0;
+}
+
+void* FrameArena::do_allocate(std::size_t bytes, std::size_t alignment)
+{
+    void* p = buffer_.data() + offset_;
+    std::size_t space = buffer_.size() - offset_;
+    if (std::align(alignment, bytes, p, space))
+    {
+        offset_ = (static_cast<std::byte*>(p) - buffer_.data()) + bytes;
+        return p;
+    }
+
+    // Out of room for this step; fall back to the heap until reset().
+    void* block = ::operator new(bytes, std::align_val_t(alignment));
+    overflow_.push_back({block, bytes, alignment});
+    overflow_bytes_ += bytes + alignment;
+    return block;
+}
+
+void FrameArena::do_deallocate(void*, std::size_t, std::size_t)
+{
+    // Monotonic: memory is only reclaimed in bulk by reset().
+}
+
+bool FrameArena::do_is_equal(const std::pmr::memory_resource& other) const noexcept
+{
+    return this == &other;
+}
+
+void FrameArena::releaseOverflow()
+{
+    for (const OverflowBlock& b : overflow_)
+        ::operator delete(b.ptr, b.bytes, std::align_val_t(b.alignment));
+    overflow_.clear();
+    overflow_bytes_ = 0;
+}
@@ -0,0 +1,59 @@
+//
+//  frame_arena.hpp
+//  Volterria
+//
+//  Created by Devin R Cohen on 10/18/26.
+//
+
+#pragma once
+
+// FrameArena: a per-step monotonic memory resource.
+// Everything the Field only needs for the duration of a single step()
+// (newborn staging, scratch lists, ...) is carved out of one buffer and
+// thrown away in bulk by reset(). If a step asks for more than the buffer
+// holds, the overflow comes from the heap and the buffer is grown at the
+// next reset(), so after warm-up a step performs no heap allocations.
+
+#include <cstddef>
+#include <memory_resource>
+#include <vector>
+
+class FrameArena : public std::pmr::memory_resource
+{
+public:
+    explicit FrameArena(std::size_t initial_bytes = 64 * 1024);
+    ~FrameArena() override;
+
+    // The arena only ever holds transient data, so copies start out empty
+    // with the same capacity instead of duplicating the bytes.
+    FrameArena(const FrameArena& other);
+    FrameArena& operator=(const FrameArena& other);
+
+    // Release everything allocated since the last reset(). Grows the
+    // backing buffer if the previous step spilled onto the heap.
+    void reset();
+
+    std::size_t capacity()      const noexcept { return buffer_.size(); }
+    std::size_t bytesInUse()    const noexcept { return offset_ + overflow_bytes_; }
+    std::size_t highWaterMark() const noexcept { return high_water_; }
+
+private:
+    void* do_allocate(std::size_t bytes, std::size_t alignment) override;
+    void  do_deallocate(void* p, std::size_t bytes, std::size_t alignment) override;
+    bool  do_is_equal(const std::pmr::memory_resource& other) const noexcept override;
+
+    void releaseOverflow();
+
+    struct OverflowBlock
+    {
+        void*       ptr;
+        std::size_t bytes;
+        std::size_t alignment;
+    };
+
+    std::vector<std::byte>     buffer_;
+    std::size_t                offset_ = 0;
+    std::vector<OverflowBlock> overflow_;
+    std::size_t                overflow_bytes_ = 0;
+    std::size_t                high_water_ = 0;
+};
@@ -0,0 +1,45 @@
+//
+//  function_ref.hpp
+//  Volterria
+//
+//  Created by Devin R Cohen on 10/18/26.
+//
+
+#pragma once
+
+// FunctionRef<R(Args...)>: a non-owning reference to any callable, for
+// parameters that are only called during the call that receives them.
+// Unlike std::function it never copies the callable, so passing a lambda
+// with any number of captures costs nothing on the heap. The callable
+// must outlive the FunctionRef; bind it to a temporary only as a
+// function argument.
+
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+template <typename Signature>
+class FunctionRef;
+
+template <typename R, typename... Args>
+class FunctionRef<R(Args...)>
+{
+public:
+    template <typename Fn,
+              typename = std::enable_if_t<!std::is_same_v<std::decay_t<Fn>, FunctionRef> &&
+                                          std::is_invocable_r_v<R, Fn&, Args...>>>
+    FunctionRef(Fn&& fn) noexcept
+        : object_(const_cast<void*>(static_cast<const void*>(std::addressof(fn)))),
+          call_([](void* object, Args... args) -> R
+          {
+              return (*static_cast<std::add_pointer_t<Fn>>(object))(std::forward<Args>(args)...);
+          })
+    {
+    }
+
+    R operator()(Args... args) const { return call_(object_, std::forward<Args>(args)...); }
+
+private:
+    void* object_;
+    R (*call_)(void*, Args...);
+};
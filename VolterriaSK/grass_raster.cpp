@@ -0,0 +1,172 @@
+//
+//  grass_raster.cpp
+//  Volterria
+//
+//  Created by Devin R Cohen on 10/18/26.
+//
+
+#include "grass_raster.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+#include "constants.hpp"
+
+void GrassRaster::configure(float x_min, float y_min, float width, float height, float cell, int block, float health)
+{
+    x_min_ = x_min;
+    y_min_ = y_min;
+    cell_ = std::max(cell, 1e-3f);
+    block_ = std::max(block, 1);
+    cols_ = std::max(1, static_cast<int>(std::ceil(width / cell_)));
+    rows_ = std::max(1, static_cast<int>(std::ceil(height / cell_)));
+    block_cols_ = (cols_ + block_ - 1) / block_;
+    block_rows_ = (rows_ + block_ - 1) / block_;
+    health_.assign(static_cast<std::size_t>(cols_) * rows_, health);
+    scratch_.clear();
+    block_best_.assign(static_cast<std::size_t>(block_cols_) * block_rows_, -1);
+    refreshBlocks(0, block_rows_);
+}
+
+void GrassRaster::reshape(float x_min, float y_min, float width, float height, float health)
+{
+    const int cols = std::max(1, static_cast<int>(std::ceil(width / cell_)));
+    const int rows = std::max(1, static_cast<int>(std::ceil(height / cell_)));
+    // Cell (x, y) of the new raster is cell (x + dx, y + dy) of the old.
+    const int dx = static_cast<int>(std::lround((x_min - x_min_) / cell_));
+    const int dy = static_cast<int>(std::lround((y_min - y_min_) / cell_));
+
+    scratch_.assign(static_cast<std::size_t>(cols) * rows, health);
+    for (int y = 0; y < rows; ++y)
+    {
+        const int oy = y + dy;
+        if (oy < 0 || oy >= rows_) continue;
+        for (int x = 0; x < cols; ++x)
+        {
+            const int ox = x + dx;
+            if (ox >= 0 && ox < cols_)
+                scratch_[static_cast<std::size_t>(y) * cols + x] = health_[static_cast<std::size_t>(oy) * cols_ + ox];
+        }
+    }
+    health_.swap(scratch_);
+
+    x_min_ = x_min_ + dx * cell_;
+    y_min_ = y_min_ + dy * cell_;
+    cols_ = cols;
+    rows_ = rows;
+    block_cols_ = (cols_ + block_ - 1) / block_;
+    block_rows_ = (rows_ + block_ - 1) / block_;
+    block_best_.assign(static_cast<std::size_t>(block_cols_) * block_rows_, -1);
+    refreshBlocks(0, block_rows_);
+}
+
+void GrassRaster::setBlock(int block, float min_health)
+{
+    block_ = std::max(block, 1);
+    block_cols_ = (cols_ + block_ - 1) / block_;
+    block_rows_ = (rows_ + block_ - 1) / block_;
+    block_best_.assign(static_cast<std::size_t>(block_cols_) * block_rows_, -1);
+    refreshBlocks(0, block_rows_, min_health);
+}
+
+void GrassRaster::clear()
+{
+    cols_ = rows_ = 0;
+    block_cols_ = block_rows_ = 0;
+    health_.clear();
+    scratch_.clear();
+    block_best_.clear();
+}
+
+void GrassRaster::assign(const std::vector<float>& health)
+{
+    if (health.size() != health_.size()) return; // configured differently
+    health_ = health;
+    refreshBlocks(0, block_rows_);
+}
+
+int GrassRaster::cellAt(const Vec2& p) const noexcept
+{
+    const int cx = std::clamp(static_cast<int>((p.x - x_min_) / cell_), 0, cols_ - 1);
+    const int cy = std::clamp(static_cast<int>((p.y - y_min_) / cell_), 0, rows_ - 1);
+    return cy * cols_ + cx;
+}
+
+Vec2 GrassRaster::center(int cell) const noexcept
+{
+    return { x_min_ + (cell % cols_ + 0.5f) * cell_, y_min_ + (cell / cols_ + 0.5f) * cell_ };
+}
+
+void GrassRaster::blockAt(const Vec2& p, int* bx, int* by) const noexcept
+{
+    const float size = blockSize();
+    *bx = std::clamp(static_cast<int>((p.x - x_min_) / size), 0, block_cols_ - 1);
+    *by = std::clamp(static_cast<int>((p.y - y_min_) / size), 0, block_rows_ - 1);
+}
+
+void GrassRaster::regrow(int row_begin, int row_end, float amount, float max_health)
+{
+    float* h = health_.data() + static_cast<std::size_t>(row_begin) * cols_;
+    const std::size_t n = static_cast<std::size_t>(row_end - row_begin) * cols_;
+    VOLTERRIA_SIMD
+    for (std::size_t i = 0; i < n; ++i)
+        h[i] = std::clamp(h[i] + amount, 0.0f, max_health);
+}
+
+void GrassRaster::beginDiffusion()
+{
+    scratch_ = health_;
+}
+
+void GrassRaster::diffuse(int row_begin, int row_end, float k)
+{
+    const int w = cols_;
+    for (int y = row_begin; y < row_end; ++y)
+    {
+        // Out-of-range neighbors read the cell itself: no flux across edges.
+        const float* s  = scratch_.data() + static_cast<std::size_t>(y) * w;
+        const float* up = y > 0 ? s - w : s;
+        const float* dn = y + 1 < rows_ ? s + w : s;
+        float* h = health_.data() + static_cast<std::size_t>(y) * w;
+
+        if (w == 1)
+        {
+            h[0] = s[0] + k * (up[0] + dn[0] - 2.0f * s[0]);
+            continue;
+        }
+        h[0] = s[0] + k * (s[1] + up[0] + dn[0] - 3.0f * s[0]);
+        VOLTERRIA_SIMD
+        for (int x = 1; x < w - 1; ++x)
+            h[x] = s[x] + k * (s[x - 1] + s[x + 1] + up[x] + dn[x] - 4.0f * s[x]);
+        h[w - 1] = s[w - 1] + k * (s[w - 2] + up[w - 1] + dn[w - 1] - 3.0f * s[w - 1]);
+    }
+}
+
+void GrassRaster::refreshBlocks(int block_row_begin, int block_row_end, float min_health)
+{
+    for (int by = block_row_begin; by < block_row_end; ++by)
+    {
+        const int y0 = by * block_;
+        const int y1 = std::min(y0 + block_, rows_);
+        for (int bx = 0; bx < block_cols_; ++bx)
+        {
+            const int x0 = bx * block_;
+            const int x1 = std::min(x0 + block_, cols_);
+            int best = -1;
+            float best_health = std::max(min_health, 0.0f);
+            for (int y = y0; y < y1; ++y)
+            {
+                const float* h = health_.data() + static_cast<std::size_t>(y) * cols_;
+                for (int x = x0; x < x1; ++x)
+                {
+                    if (h[x] > best_health)
+                    {
+                        best_health = h[x];
+                        best = y * cols_ + x;
+                    }
+                }
+            }
+            block_best_[by * block_cols_ + bx] = best;
+        }
+    }
+}
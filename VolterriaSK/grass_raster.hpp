@@ -0,0 +1,111 @@
+//
+//  grass_raster.hpp
+//  Volterria
+//
+//  Created by Devin R Cohen on 10/18/26.
+//
+
+#pragma once
+
+// GrassRaster: vegetation as a dense row-major grid of health values,
+// the fine-grained alternative to a handful of GrassPatch disks (see
+// Settings::grass_raster). Cells are square and laid over the world from
+// (x_min, y_min). The Field groups them into blocks of block x block cells
+// the size of its spatial grid's cells, and re-blocks them whenever the
+// grid's cell size changes (setBlock()). The cells themselves stay put;
+// a block matches a grid cell exactly when the grid's cell size is a
+// whole number of raster cells, as it is when the raster is created.
+//
+// Everything per step is a flat pass over rows, split into row ranges so
+// the Field can hand them to its workers: regrowth is one clamped add per
+// cell, diffusion a 5-point stencil against a copy of the last state, and
+// refreshBlocks() records each block's healthiest cell so perception can
+// search blocks instead of cells. A creature's cell is an index
+// computation, so grazing is O(1) per creature.
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "creature.hpp"
+
+class GrassRaster
+{
+public:
+    // Cover [x_min, x_min + width) x [y_min, y_min + height) in cells of
+    // `cell` world units, all at `health`. Keeps capacity across calls.
+    void configure(float x_min, float y_min, float width, float height, float cell, int block, float health);
+    void clear();
+
+    // Cover a new extent with the same cells: cells still inside keep
+    // their health, new ones start at `health`.
+    void reshape(float x_min, float y_min, float width, float height, float health);
+
+    bool empty() const noexcept { return health_.empty(); }
+    int cols() const noexcept { return cols_; }
+    int rows() const noexcept { return rows_; }
+    std::size_t size() const noexcept { return health_.size(); }
+    float cellSize() const noexcept { return cell_; }
+
+    // Row-major (y outer) cell health.
+    const std::vector<float>& health() const noexcept { return health_; }
+    float health(int cell) const noexcept { return health_[cell]; }
+
+    // Put back health captured from an identically configured raster.
+    void assign(const std::vector<float>& health);
+
+    // The cell holding p, clamped to the raster's edge.
+    int cellAt(const Vec2& p) const noexcept;
+    Vec2 center(int cell) const noexcept;
+
+    // Take up to `bite` from a cell; returns how much was there to take.
+    float graze(int cell, float bite) noexcept
+    {
+        const float taken = bite < health_[cell] ? bite : health_[cell];
+        health_[cell] -= taken;
+        return taken;
+    }
+
+    // Add `amount` to every cell of rows [row_begin, row_end), capped at
+    // max_health.
+    void regrow(int row_begin, int row_end, float amount, float max_health);
+
+    // Spread health towards neighboring cells: each cell moves by k times
+    // the sum of its differences to its four neighbors (k <= 1/4 keeps
+    // it stable; edges don't leak). beginDiffusion() snapshots the state
+    // every diffuse() range then reads from.
+    void beginDiffusion();
+    void diffuse(int row_begin, int row_end, float k);
+
+    // Blocks: block x block cells, one per spatial grid cell.
+    // setBlock() regroups the same cells (health is untouched) and
+    // refreshes every block's best cell at min_health.
+    void setBlock(int block, float min_health = 0.0f);
+    int block() const noexcept { return block_; }
+    int blockCols() const noexcept { return block_cols_; }
+    int blockRows() const noexcept { return block_rows_; }
+    float blockSize() const noexcept { return cell_ * block_; }
+    void blockAt(const Vec2& p, int* bx, int* by) const noexcept;
+
+    // Recompute the healthiest cell of every block in block rows
+    // [block_row_begin, block_row_end); cells at or below min_health
+    // don't count.
+    void refreshBlocks(int block_row_begin, int block_row_end, float min_health = 0.0f);
+
+    // Index of block (bx, by)'s healthiest cell as of the last
+    // refreshBlocks(), or -1 if none of its cells counted.
+    int bestInBlock(int bx, int by) const noexcept { return block_best_[by * block_cols_ + bx]; }
+
+private:
+    float x_min_ = 0.0f;
+    float y_min_ = 0.0f;
+    float cell_ = 1.0f;
+    int cols_ = 0;
+    int rows_ = 0;
+    int block_ = 1;
+    int block_cols_ = 0;
+    int block_rows_ = 0;
+    std::vector<float> health_;
+    std::vector<float> scratch_; // last state, for diffusion
+    std::vector<int32_t> block_best_;
+};
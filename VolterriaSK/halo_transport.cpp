@@ -0,0 +1,219 @@
+//
+//  halo_transport.cpp
+//  Volterria
+//
+//  Created by Devin R Cohen on 10/18/26.
+//
+
+#include "halo_transport.hpp"
+
+#include <cerrno>
+#include <condition_variable>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <iostream>
+#include <mutex>
+
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+// MARK: - Loopback
+
+struct LoopbackTransport::Hub
+{
+    explicit Hub(int n) : size(n), boxes(static_cast<std::size_t>(n) * n) {}
+
+    int size;
+    std::mutex mutex;
+    std::condition_variable arrived;
+    std::vector<std::deque<Message>> boxes; // [from * size + to]
+};
+
+std::vector<std::unique_ptr<HaloTransport>> LoopbackTransport::createGroup(int size)
+{
+    auto hub = std::make_shared<Hub>(size);
+    std::vector<std::unique_ptr<HaloTransport>> out;
+    for (int r = 0; r < size; ++r)
+        out.push_back(std::unique_ptr<HaloTransport>(new LoopbackTransport(hub, r)));
+    return out;
+}
+
+int LoopbackTransport::size() const noexcept
+{
+    return hub_->size;
+}
+
+bool LoopbackTransport::exchange(const std::vector<int>& peers,
+                                 const std::vector<Message>& outgoing,
+                                 std::vector<Message>& incoming)
+{
+    const int n = hub_->size;
+    incoming.resize(peers.size());
+
+    std::unique_lock<std::mutex> lock(hub_->mutex);
+    for (std::size_t k = 0; k < peers.size(); ++k)
+        hub_->boxes[rank_ * n + peers[k]].push_back(outgoing[k]);
+    hub_->arrived.notify_all();
+
+    // Mailboxes are FIFO, so the front is always this round's message.
+    for (std::size_t k = 0; k < peers.size(); ++k)
+    {
+        auto& box = hub_->boxes[peers[k] * n + rank_];
+        hub_->arrived.wait(lock, [&] { return !box.empty(); });
+        incoming[k] = std::move(box.front());
+        box.pop_front();
+    }
+    return true;
+}
+
+// MARK: - Unix sockets
+
+SocketTransport::Mesh::Mesh(int size)
+    : size_(size), fds_(static_cast<std::size_t>(size) * size, -1)
+{
+    for (int a = 0; a < size; ++a)
+    {
+        for (int b = a + 1; b < size; ++b)
+        {
+            int sv[2];
+            if (socketpair(AF_UNIX, SOCK_STREAM, 0, sv) != 0)
+            {
+                std::cerr << "socketpair failed: " << std::strerror(errno) << "\n";
+                return;
+            }
+            fds_[a * size + b] = sv[0];
+            fds_[b * size + a] = sv[1];
+        }
+    }
+    valid_ = true;
+}
+
+SocketTransport::Mesh::~Mesh()
+{
+    for (int fd : fds_)
+        if (fd >= 0) close(fd);
+}
+
+std::unique_ptr<SocketTransport> SocketTransport::Mesh::endpoint(int rank)
+{
+    if (!valid_ || rank < 0 || rank >= size_) return nullptr;
+
+    std::vector<int> mine(size_, -1);
+    for (int a = 0; a < size_; ++a)
+    {
+        for (int b = 0; b < size_; ++b)
+        {
+            int& fd = fds_[a * size_ + b];
+            if (fd < 0) continue;
+            if (a == rank)
+            {
+                mine[b] = fd;
+                fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+            }
+            else close(fd); // someone else's end
+            fd = -1;
+        }
+    }
+    valid_ = false; // a process takes at most one endpoint
+    return std::unique_ptr<SocketTransport>(new SocketTransport(rank, std::move(mine)));
+}
+
+SocketTransport::~SocketTransport()
+{
+    for (int fd : fds_)
+        if (fd >= 0) close(fd);
+}
+
+bool SocketTransport::exchange(const std::vector<int>& peers,
+                               const std::vector<Message>& outgoing,
+                               std::vector<Message>& incoming)
+{
+    // Per peer: an 8-byte length then the payload, each way.
+    struct Progress
+    {
+        uint64_t send_len = 0;
+        std::size_t sent = 0;     // of 8 + send_len
+        unsigned char recv_head[8];
+        std::size_t received = 0; // of 8 + recv_len
+        uint64_t recv_len = 0;
+    };
+    std::vector<Progress> progress(peers.size());
+    incoming.assign(peers.size(), {});
+    for (std::size_t k = 0; k < peers.size(); ++k)
+        progress[k].send_len = outgoing[k].size();
+
+    std::vector<pollfd> polls;
+    std::vector<std::size_t> which;
+    for (;;)
+    {
+        polls.clear();
+        which.clear();
+        for (std::size_t k = 0; k < peers.size(); ++k)
+        {
+            const Progress& p = progress[k];
+            short events = 0;
+            if (p.sent < 8 + p.send_len) events |= POLLOUT;
+            if (p.received < 8 || p.received < 8 + p.recv_len) events |= POLLIN;
+            if (!events) continue;
+            polls.push_back({fds_[peers[k]], events, 0});
+            which.push_back(k);
+        }
+        if (polls.empty()) return true;
+
+        if (poll(polls.data(), polls.size(), -1) < 0)
+        {
+            if (errno == EINTR) continue;
+            std::cerr << "poll failed: " << std::strerror(errno) << "\n";
+            return false;
+        }
+
+        for (std::size_t j = 0; j < polls.size(); ++j)
+        {
+            Progress& p = progress[which[j]];
+            const int fd = polls[j].fd;
+            const Message& out = outgoing[which[j]];
+            Message& in = incoming[which[j]];
+
+            if (polls[j].revents & POLLOUT)
+            {
+                ssize_t n;
+                if (p.sent < 8)
+                {
+                    unsigned char head[8];
+                    std::memcpy(head, &p.send_len, 8);
+                    n = send(fd, head + p.sent, 8 - p.sent, MSG_NOSIGNAL);
+                }
+                else
+                {
+                    n = send(fd, out.data() + (p.sent - 8), out.size() - (p.sent - 8), MSG_NOSIGNAL);
+                }
+                if (n < 0 && errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR) return false;
+                if (n > 0) p.sent += static_cast<std::size_t>(n);
+            }
+
+            if (polls[j].revents & (POLLIN | POLLHUP | POLLERR))
+            {
+                ssize_t n;
+                if (p.received < 8)
+                {
+                    n = recv(fd, p.recv_head + p.received, 8 - p.received, 0);
+                    if (n > 0 && p.received + n == 8)
+                    {
+                        std::memcpy(&p.recv_len, p.recv_head, 8);
+                        in.resize(p.recv_len);
+                    }
+                }
+                else
+                {
+                    n = recv(fd, in.data() + (p.received - 8), in.size() - (p.received - 8), 0);
+                }
+                if (n == 0) return false; // peer closed
+                if (n < 0 && errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR) return false;
+                if (n > 0) p.received += static_cast<std::size_t>(n);
+            }
+        }
+    }
+}
@@ -0,0 +1,105 @@
+//
+//  halo_transport.hpp
+//  Volterria
+//
+//  Created by Devin R Cohen on 10/18/26.
+//
+
+#pragma once
+
+// HaloTransport: how subdomains (see domain.hpp) talk to each other.
+//
+// Communication is in rounds: every rank calls exchange() with the same
+// symmetric peer lists, sends one message (possibly empty) to each peer
+// and gets one back from each. Rounds are matched by order, so all ranks
+// must make the same sequence of exchange() calls.
+//
+// Two implementations for a single box: LoopbackTransport connects ranks
+// running as threads of one process; SocketTransport connects processes
+// through Unix socket pairs created before fork(). A networked transport
+// only has to implement exchange().
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+class HaloTransport
+{
+public:
+    using Message = std::vector<std::byte>;
+
+    virtual ~HaloTransport() = default;
+
+    virtual int rank() const noexcept = 0;
+    virtual int size() const noexcept = 0;
+
+    // Send outgoing[k] to peers[k] and receive incoming[k] from it. Blocks
+    // until the round is complete; false if a peer went away.
+    virtual bool exchange(const std::vector<int>& peers,
+                          const std::vector<Message>& outgoing,
+                          std::vector<Message>& incoming) = 0;
+};
+
+// Ranks as threads of one process, trading messages through shared
+// mailboxes.
+class LoopbackTransport : public HaloTransport
+{
+public:
+    // One endpoint per rank, all on the same hub; hand each to its thread.
+    static std::vector<std::unique_ptr<HaloTransport>> createGroup(int size);
+
+    int rank() const noexcept override { return rank_; }
+    int size() const noexcept override;
+    bool exchange(const std::vector<int>& peers,
+                  const std::vector<Message>& outgoing,
+                  std::vector<Message>& incoming) override;
+
+private:
+    struct Hub;
+    LoopbackTransport(std::shared_ptr<Hub> hub, int rank) : hub_(std::move(hub)), rank_(rank) {}
+
+    std::shared_ptr<Hub> hub_;
+    int rank_;
+};
+
+// Ranks as processes on one host, over a full mesh of Unix socket pairs.
+// Messages are length-prefixed; sends and receives are interleaved with
+// poll() so two ranks sending large halos to each other can't deadlock
+// on full socket buffers.
+class SocketTransport : public HaloTransport
+{
+public:
+    // Socket pairs for every pair of ranks in a group. Create it before
+    // forking; each process then takes its own endpoint, which closes the
+    // descriptors belonging to everyone else.
+    class Mesh
+    {
+    public:
+        explicit Mesh(int size);
+        ~Mesh();
+        Mesh(const Mesh&) = delete;
+        Mesh& operator=(const Mesh&) = delete;
+
+        bool valid() const noexcept { return valid_; }
+        std::unique_ptr<SocketTransport> endpoint(int rank);
+
+    private:
+        int size_;
+        bool valid_ = false;
+        std::vector<int> fds_; // [a * size + b]: a's end of the a <-> b pair, -1 once closed
+    };
+
+    ~SocketTransport() override;
+
+    int rank() const noexcept override { return rank_; }
+    int size() const noexcept override { return static_cast<int>(fds_.size()); }
+    bool exchange(const std::vector<int>& peers,
+                  const std::vector<Message>& outgoing,
+                  std::vector<Message>& incoming) override;
+
+private:
+    SocketTransport(int rank, std::vector<int> fds) : rank_(rank), fds_(std::move(fds)) {}
+
+    int rank_;
+    std::vector<int> fds_; // by peer rank; -1 for self
+};
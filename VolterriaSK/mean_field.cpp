@@ -0,0 +1,108 @@
+//
+//  mean_field.cpp
+//  Volterria
+//
+//  Created by Devin R Cohen on 10/18/26.
+//
+
+#include "mean_field.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+void MeanFieldFit::begin(const FieldTallies& tallies)
+{
+    active_ = true;
+    start_ = tallies;
+    seconds_ = 0.0;
+    prey_seconds_ = 0.0;
+    predator_seconds_ = 0.0;
+    encounter_seconds_ = 0.0;
+}
+
+void MeanFieldFit::sample(double dt, int prey, int predators)
+{
+    if (!active_) return;
+    seconds_ += dt;
+    prey_seconds_ += dt * prey;
+    predator_seconds_ += dt * predators;
+    encounter_seconds_ += dt * prey * static_cast<double>(predators);
+}
+
+bool MeanFieldFit::fit(const FieldTallies& tallies, double prey_capacity, double min_window, MeanFieldRates* out) const
+{
+    if (!active_ || prey_seconds_ <= 0.0 || seconds_ < min_window) return false;
+
+    auto delta = [&](FieldEventType type, SpeciesRole species)
+    {
+        return static_cast<double>(tallies.count(type, species) - start_.count(type, species));
+    };
+    auto per = [](double events, double exposure) { return exposure > 0.0 ? events / exposure : 0.0; };
+
+    const double prey_born      = delta(FieldEventType::Born, SpeciesRole::Prey);
+    const double prey_died      = delta(FieldEventType::Starved, SpeciesRole::Prey)
+                                + delta(FieldEventType::DiedOfAge, SpeciesRole::Prey);
+    const double prey_eaten     = delta(FieldEventType::Eaten, SpeciesRole::Prey);
+    const double predators_born = delta(FieldEventType::Born, SpeciesRole::Predator);
+    const double predators_died = delta(FieldEventType::Starved, SpeciesRole::Predator)
+                                + delta(FieldEventType::DiedOfAge, SpeciesRole::Predator);
+
+    if (prey_born < kMinEvents || prey_died < kMinEvents) return false;
+    if (predator_seconds_ > 0.0 &&
+        (prey_eaten < kMinEvents || predators_born < kMinEvents || predators_died < kMinEvents))
+        return false;
+
+    MeanFieldRates r;
+    r.prey_birth     = per(prey_born, prey_seconds_);
+    r.prey_death     = per(prey_died, prey_seconds_);
+    r.predation      = per(prey_eaten, encounter_seconds_);
+    r.predator_birth = per(predators_born, encounter_seconds_);
+    r.predator_death = per(predators_died, predator_seconds_);
+    r.prey_capacity  = std::max(prey_capacity, 0.0);
+    *out = r;
+    return true;
+}
+
+namespace
+{
+    struct Rate { double dx, dy; };
+
+    Rate derivative(const MeanFieldRates& r, double x, double y)
+    {
+        const double crowding = r.prey_capacity > 0.0 ? 1.0 - x / r.prey_capacity : 1.0;
+        return {
+            r.prey_birth * x * crowding - r.prey_death * x - r.predation * x * y,
+            r.predator_birth * x * y - r.predator_death * y
+        };
+    }
+}
+
+PopulationSample integrateMeanField(const MeanFieldRates& rates, PopulationSample start,
+                                    double seconds, double h, std::vector<PopulationSample>* curve)
+{
+    PopulationSample s = start;
+    if (h <= 0.0) h = seconds;
+    const int steps = seconds > 0.0 ? static_cast<int>(std::ceil(seconds / h)) : 0;
+    const double end = start.time + seconds;
+
+    for (int i = 0; i < steps; ++i)
+    {
+        const double dt = std::min(h, end - s.time);
+        const double x = s.prey, y = s.predators;
+        const Rate k1 = derivative(rates, x, y);
+        const Rate k2 = derivative(rates, x + 0.5 * dt * k1.dx, y + 0.5 * dt * k1.dy);
+        const Rate k3 = derivative(rates, x + 0.5 * dt * k2.dx, y + 0.5 * dt * k2.dy);
+        const Rate k4 = derivative(rates, x + dt * k3.dx, y + dt * k3.dy);
+        s.prey      = x + dt / 6.0 * (k1.dx + 2.0 * k2.dx + 2.0 * k3.dx + k4.dx);
+        s.predators = y + dt / 6.0 * (k1.dy + 2.0 * k2.dy + 2.0 * k3.dy + k4.dy);
+        s.time += dt;
+
+        // The agents come in whole creatures; without this the model's
+        // fractional survivors would bounce back from nothing.
+        if (s.prey < 0.5) s.prey = 0.0;
+        if (s.predators < 0.5) s.predators = 0.0;
+
+        if (curve) curve->push_back(s);
+    }
+    return s;
+}
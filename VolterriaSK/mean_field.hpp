@@ -0,0 +1,82 @@
+//
+//  mean_field.hpp
+//  Volterria
+//
+//  Created by Devin R Cohen on 10/18/26.
+//
+
+#pragma once
+
+// Mean-field model of the population: Lotka–Volterra with rates fitted
+// from an agent-based window, for when only the long-horizon counts
+// matter.
+//
+//   dx/dt = a x (1 - x/K) - m x - b x y      x: prey
+//   dy/dt = d x y         - n y              y: predators
+//
+// Each rate is events over exposure in the window: prey births per prey
+// second (a), prey starvation + old age per prey second (m), prey eaten
+// per prey-predator second (b), predator births per prey-predator second
+// (d), predator deaths per predator second (n). K is
+// Settings::mean_field_prey_capacity; 0 leaves prey growth unbounded.
+
+#include <cstdint>
+#include <vector>
+
+#include "field_events.hpp"
+
+struct MeanFieldRates
+{
+    double prey_birth = 0.0;     // a
+    double prey_death = 0.0;     // m
+    double predation = 0.0;      // b
+    double predator_birth = 0.0; // d
+    double predator_death = 0.0; // n
+    double prey_capacity = 0.0;  // K, 0 = none
+};
+
+struct PopulationSample
+{
+    double time;
+    double prey;
+    double predators;
+};
+
+// Accumulates exposure (population integrated over time) between begin()
+// and fit(); event counts come from the Field's tallies at both ends.
+class MeanFieldFit
+{
+public:
+    void begin(const FieldTallies& tallies);
+    void clear() { active_ = false; }
+    void sample(double dt, int prey, int predators);
+
+    // A rate measured from a handful of events is noise, and one from
+    // none is an exact zero the model would take literally (immortal
+    // predators, say). So fit() needs at least kMinEvents behind every
+    // rate, and a window of at least min_window seconds (a species' life
+    // span, so old age has had a chance to show up).
+    static constexpr int kMinEvents = 5;
+
+    // False if the window saw no prey, is shorter than min_window, or left
+    // some rate with fewer than kMinEvents events. Predator rates are only
+    // required while there were predators to measure.
+    bool fit(const FieldTallies& tallies, double prey_capacity, double min_window, MeanFieldRates* out) const;
+
+    bool active() const noexcept { return active_; }
+    double window() const noexcept { return seconds_; }
+
+private:
+    bool active_ = false;
+    FieldTallies start_;
+    double seconds_ = 0.0;
+    double prey_seconds_ = 0.0;      // integral of x dt
+    double predator_seconds_ = 0.0;  // integral of y dt
+    double encounter_seconds_ = 0.0; // integral of x y dt
+};
+
+// Integrate the model from `start` over `seconds` with fixed RK4 steps of
+// `h`, appending a sample per step to `curve` (if given). Populations
+// under half an individual are extinct and stay at zero.
+PopulationSample integrateMeanField(const MeanFieldRates& rates, PopulationSample start,
+                                    double seconds, double h, std::vector<PopulationSample>* curve);
@@ -0,0 +1,120 @@
+//
+//  neighbor_lists.hpp
+//  Volterria
+//
+//  Created by Devin R Cohen on 10/18/26.
+//
+
+#pragma once
+
+// NeighborLists: Verlet-style per-creature candidate lists.
+// Each creature's list holds the handles of everyone within its search
+// radius plus a skin at build time. Until some creature has moved more
+// than half the skin, every pair that is now within the search radius is
+// still in those lists, so perception and interactions can walk them
+// instead of rescanning grid cells. Creatures born after the build have
+// no list of their own and sit in a pending list everyone also checks.
+//
+// Each list is split: entries within the interaction radius + skin come
+// first (nearList), so eat/mate tests don't wade through the whole
+// vision range.
+//
+// Lists are keyed by slot index and stored back to back (CSR style);
+// handles survive swap-and-pop erases and Morton reorders, and a handle
+// whose creature has died simply stops resolving.
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "creature.hpp"
+#include "slot_map.hpp"
+
+class NeighborLists
+{
+public:
+    struct Range
+    {
+        const SlotHandle* first;
+        const SlotHandle* last;
+        const SlotHandle* begin() const noexcept { return first; }
+        const SlotHandle* end()   const noexcept { return last; }
+    };
+
+    // Start a build covering slots [0, slot_count).
+    void beginBuild(std::size_t slot_count)
+    {
+        owner_.assign(slot_count, SlotHandle{});
+        first_.resize(slot_count);
+        count_.resize(slot_count);
+        near_count_.resize(slot_count);
+        reference_.resize(slot_count);
+        handles_.clear();
+        pending_.clear();
+        built_ = true;
+        ++builds_;
+    }
+
+    // Lists are written one owner at a time: beginList, push..., endList.
+    // `near` marks entries within interaction range + skin.
+    void beginList(SlotHandle owner, const Vec2& position)
+    {
+        owner_[owner.index] = owner;
+        first_[owner.index] = static_cast<uint32_t>(handles_.size());
+        reference_[owner.index] = position;
+        current_ = owner.index;
+    }
+    void push(SlotHandle h, bool near)
+    {
+        if (near) near_.push_back(h);
+        else handles_.push_back(h);
+    }
+    void endList()
+    {
+        // Near entries were held back; move them in front of the rest.
+        const uint32_t first = first_[current_];
+        handles_.insert(handles_.begin() + first, near_.begin(), near_.end());
+        count_[current_] = static_cast<uint32_t>(handles_.size()) - first;
+        near_count_[current_] = static_cast<uint32_t>(near_.size());
+        near_.clear();
+    }
+
+    void addPending(SlotHandle h) { if (built_) pending_.push_back(h); }
+    void invalidate() noexcept { built_ = false; }
+
+    bool built() const noexcept { return built_; }
+    bool hasList(SlotHandle h) const noexcept { return built_ && h.index < owner_.size() && owner_[h.index] == h; }
+    Range list(SlotHandle h) const noexcept
+    {
+        const SlotHandle* base = handles_.data() + first_[h.index];
+        return { base, base + count_[h.index] };
+    }
+    Range nearList(SlotHandle h) const noexcept
+    {
+        const SlotHandle* base = handles_.data() + first_[h.index];
+        return { base, base + near_count_[h.index] };
+    }
+    const Vec2& reference(SlotHandle h) const noexcept { return reference_[h.index]; }
+    const std::vector<SlotHandle>& pending() const noexcept { return pending_; }
+    uint64_t builds() const noexcept { return builds_; }
+    std::size_t bytes() const noexcept
+    {
+        return owner_.capacity() * sizeof(SlotHandle) + first_.capacity() * sizeof(uint32_t)
+             + count_.capacity() * sizeof(uint32_t) + near_count_.capacity() * sizeof(uint32_t)
+             + reference_.capacity() * sizeof(Vec2) + handles_.capacity() * sizeof(SlotHandle)
+             + pending_.capacity() * sizeof(SlotHandle) + near_.capacity() * sizeof(SlotHandle);
+    }
+
+private:
+    std::vector<SlotHandle> owner_;     // by slot: whose list it is, null if none
+    std::vector<uint32_t>   first_;     // by slot: offset into handles_
+    std::vector<uint32_t>   count_;     // by slot
+    std::vector<uint32_t>   near_count_; // by slot: leading entries within interaction range
+    std::vector<Vec2>       reference_; // by slot: position at build
+    std::vector<SlotHandle> handles_;
+    std::vector<SlotHandle> pending_;   // born since the build, no list of their own
+    std::vector<SlotHandle> near_;      // scratch for the list being written
+    uint32_t current_ = 0;
+    bool built_ = false;
+    uint64_t builds_ = 0;
+};
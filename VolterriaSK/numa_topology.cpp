@@ -0,0 +1,126 @@
+//
+//  numa_topology.cpp
+//  Volterria
+//
+//  Created by Devin R Cohen on 10/18/26.
+//
+
+#include "numa_topology.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <cstdint>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+
+#if defined(__linux__)
+#include <dirent.h>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace
+{
+    // "0-3,8-11" -> 0 1 2 3 8 9 10 11
+    std::vector<int> parseCpuList(const std::string& text)
+    {
+        std::vector<int> out;
+        std::stringstream ss(text);
+        std::string part;
+        while (std::getline(ss, part, ','))
+        {
+            if (part.empty() || part == "\n") continue;
+            const std::size_t dash = part.find('-');
+            const int lo = std::stoi(part.substr(0, dash));
+            const int hi = dash == std::string::npos ? lo : std::stoi(part.substr(dash + 1));
+            for (int c = lo; c <= hi; ++c)
+                out.push_back(c);
+        }
+        return out;
+    }
+}
+
+NumaTopology NumaTopology::detect()
+{
+    NumaTopology t;
+#if defined(__linux__)
+    if (DIR* dir = opendir("/sys/devices/system/node"))
+    {
+        std::vector<int> ids;
+        while (dirent* e = readdir(dir))
+        {
+            const std::string name = e->d_name;
+            if (name.rfind("node", 0) == 0 && name.size() > 4 && std::isdigit(static_cast<unsigned char>(name[4])))
+                ids.push_back(std::stoi(name.substr(4)));
+        }
+        closedir(dir);
+        std::sort(ids.begin(), ids.end());
+        for (int id : ids)
+        {
+            std::ifstream in("/sys/devices/system/node/node" + std::to_string(id) + "/cpulist");
+            std::string text;
+            std::getline(in, text);
+            std::vector<int> cpus = parseCpuList(text);
+            if (cpus.empty()) continue; // memory-only node
+            t.node_ids_.push_back(id);
+            t.node_cpus_.push_back(std::move(cpus));
+        }
+    }
+#endif
+    if (t.node_cpus_.empty())
+    {
+        std::vector<int> all(std::max(1u, std::thread::hardware_concurrency()));
+        for (std::size_t c = 0; c < all.size(); ++c)
+            all[c] = static_cast<int>(c);
+        t.node_ids_.assign(1, 0);
+        t.node_cpus_.push_back(std::move(all));
+    }
+    return t;
+}
+
+bool NumaTopology::pinCurrentThread(int node) const
+{
+#if defined(__linux__)
+    if (node < 0 || node >= nodes()) return false;
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    for (int c : node_cpus_[node])
+        CPU_SET(c, &set);
+    return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+#else
+    (void)node;
+    return false;
+#endif
+}
+
+bool NumaTopology::placePages(const void* data, std::size_t bytes, int node) const
+{
+#if defined(__linux__) && defined(SYS_mbind)
+    if (node < 0 || node >= nodes() || nodes() < 2) return false;
+    const uintptr_t page = static_cast<uintptr_t>(sysconf(_SC_PAGESIZE));
+    const uintptr_t begin = (reinterpret_cast<uintptr_t>(data) + page - 1) & ~(page - 1);
+    const uintptr_t end = (reinterpret_cast<uintptr_t>(data) + bytes) & ~(page - 1);
+    if (end <= begin) return false;
+
+    constexpr int kMpolPreferred = 1;   // MPOL_PREFERRED
+    constexpr unsigned kMpolMfMove = 2; // MPOL_MF_MOVE: migrate pages already touched
+    // Called on every reorder, so the mask lives on the stack; 1024 is the
+    // kernel's default MAX_NUMNODES.
+    constexpr int kWordBits = 8 * sizeof(unsigned long);
+    std::array<unsigned long, 1024 / kWordBits> mask{};
+    const int id = node_ids_[node];
+    if (id >= 1024) return false;
+    mask[id / kWordBits] = 1ul << (id % kWordBits);
+    const std::size_t words = id / kWordBits + 1;
+    return syscall(SYS_mbind, begin, end - begin, kMpolPreferred, mask.data(),
+                   words * kWordBits, kMpolMfMove) == 0;
+#else
+    (void)data; (void)bytes; (void)node;
+    return false;
+#endif
+}
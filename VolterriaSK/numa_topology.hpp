@@ -0,0 +1,37 @@
+//
+//  numa_topology.hpp
+//  Volterria
+//
+//  Created by Devin R Cohen on 10/18/26.
+//
+
+#pragma once
+
+// NumaTopology: which CPUs belong to which NUMA node, read from sysfs on
+// Linux. Everywhere else (and on single-socket machines) it reports one
+// node holding every CPU, and pinning / page placement quietly do
+// nothing, so callers don't need their own platform checks.
+
+#include <cstddef>
+#include <vector>
+
+class NumaTopology
+{
+public:
+    static NumaTopology detect();
+
+    int nodes() const noexcept { return static_cast<int>(node_cpus_.size()); }
+    const std::vector<int>& cpus(int node) const { return node_cpus_[node]; }
+
+    // Restrict the calling thread to the CPUs of `node`.
+    bool pinCurrentThread(int node) const;
+
+    // Move the whole pages inside [data, data + bytes) to `node` and keep
+    // them there. Pages straddling the range's ends are left alone; they
+    // are the ones a neighboring range shares.
+    bool placePages(const void* data, std::size_t bytes, int node) const;
+
+private:
+    std::vector<std::vector<int>> node_cpus_;
+    std::vector<int> node_ids_; // sysfs numbering may have gaps
+};
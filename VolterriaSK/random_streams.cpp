@@ -0,0 +1,110 @@
+//
+//  random_streams.cpp
+//  Volterria
+//
+//  Created by Devin R Cohen on 10/18/26.
+//
+
+#include "random_streams.hpp"
+
+#include <cmath>
+#include <random>
+
+#include "constants.hpp"
+
+namespace
+{
+    // SplitMix64 finalizer: a strong 64-bit mix of (key + counter).
+    inline uint64_t mix64(uint64_t z)
+    {
+        z += 0x9E3779B97F4A7C15ull;
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+        return z ^ (z >> 31);
+    }
+
+    // Top 24 bits -> float in [0, 1).
+    inline float toUnit(uint64_t bits)
+    {
+        return static_cast<float>(bits >> 40) * 0x1.0p-24f;
+    }
+
+    constexpr float kTwoPi = 6.28318530717958647692f;
+}
+
+RandomStream::RandomStream(uint64_t seed, uint64_t stream_id)
+{
+    reseed(seed, stream_id);
+}
+
+void RandomStream::reseed(uint64_t seed, uint64_t stream_id)
+{
+    key_ = mix64(seed ^ mix64(stream_id));
+    counter_ = 0;
+    cursor_ = kChunk;
+}
+
+uint64_t RandomStream::entropySeed()
+{
+    std::random_device rd;
+    return (static_cast<uint64_t>(rd()) << 32) ^ rd();
+}
+
+void RandomStream::fillUniform(float* out, std::size_t n, float lo, float hi)
+{
+    const uint64_t key = key_;
+    const uint64_t base = counter_;
+    const float span = hi - lo;
+    VOLTERRIA_SIMD
+    for (std::size_t i = 0; i < n; ++i)
+        out[i] = lo + span * toUnit(mix64(key + base + i));
+    counter_ += n;
+}
+
+void RandomStream::fillNormal(float* out, std::size_t n, float mean, float stdev)
+{
+    // Box-Muller, two outputs per pair of uniforms.
+    const uint64_t key = key_;
+    const uint64_t base = counter_;
+    const std::size_t pairs = (n + 1) / 2;
+    for (std::size_t k = 0; k < pairs; ++k)
+    {
+        const float u1 = 1.0f - toUnit(mix64(key + base + 2 * k)); // (0, 1], keeps log finite
+        const float u2 = toUnit(mix64(key + base + 2 * k + 1));
+        const float r = stdev * std::sqrt(-2.0f * std::log(u1));
+        out[2 * k] = mean + r * std::cos(kTwoPi * u2);
+        if (2 * k + 1 < n)
+            out[2 * k + 1] = mean + r * std::sin(kTwoPi * u2);
+    }
+    counter_ += 2 * pairs;
+}
+
+void RandomStream::fillBernoulli(uint8_t* out, std::size_t n, float p)
+{
+    const uint64_t key = key_;
+    const uint64_t base = counter_;
+    VOLTERRIA_SIMD
+    for (std::size_t i = 0; i < n; ++i)
+        out[i] = toUnit(mix64(key + base + i)) < p;
+    counter_ += n;
+}
+
+float RandomStream::uniform()
+{
+    if (cursor_ == kChunk)
+        refill();
+    return chunk_[cursor_++];
+}
+
+float RandomStream::normal(float mean, float stdev)
+{
+    const float u1 = 1.0f - uniform();
+    const float u2 = uniform();
+    return mean + stdev * std::sqrt(-2.0f * std::log(u1)) * std::cos(kTwoPi * u2);
+}
+
+void RandomStream::refill()
+{
+    fillUniform(chunk_, kChunk, 0.0f, 1.0f);
+    cursor_ = 0;
+}
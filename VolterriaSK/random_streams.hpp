@@ -0,0 +1,51 @@
+//
+//  random_streams.hpp
+//  Volterria
+//
+//  Created by Devin R Cohen on 10/18/26.
+//
+
+#pragma once
+
+// RandomStream: counter-based random numbers generated in bulk.
+// Value k of a stream is a pure function of (seed, stream id, k), so
+// filling a buffer is a flat loop with no carried state that the
+// compiler can vectorize, and a given seed always reproduces the same
+// sequence. Hot paths take a pre-filled slice (e.g. two wander values per
+// creature per step); irregular consumers such as births use the
+// buffered scalar draws, which refill a chunk at a time.
+
+#include <cstddef>
+#include <cstdint>
+
+class RandomStream
+{
+public:
+    explicit RandomStream(uint64_t seed = 0, uint64_t stream_id = 0);
+
+    void reseed(uint64_t seed, uint64_t stream_id);
+
+    // Bulk fills.
+    void fillUniform(float* out, std::size_t n, float lo, float hi);
+    void fillNormal(float* out, std::size_t n, float mean, float stdev);
+    void fillBernoulli(uint8_t* out, std::size_t n, float p);
+
+    // Buffered scalar draws.
+    float uniform(); // [0, 1)
+    float uniform(float lo, float hi) { return lo + (hi - lo) * uniform(); }
+    float normal(float mean, float stdev);
+    bool  bernoulli(float p) { return uniform() < p; }
+
+    // Fresh 64-bit seed from std::random_device, for unseeded runs.
+    static uint64_t entropySeed();
+
+private:
+    static constexpr std::size_t kChunk = 256;
+
+    void refill();
+
+    uint64_t key_ = 0;
+    uint64_t counter_ = 0;          // next counter value to generate
+    float    chunk_[kChunk];
+    std::size_t cursor_ = kChunk;   // next unread value in chunk_
+};
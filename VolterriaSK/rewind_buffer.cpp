@@ -0,0 +1,108 @@
+//
+//  rewind_buffer.cpp
+//  Volterria
+//
+//  Created by Devin R Cohen on 10/18/26.
+//
+
+#include "rewind_buffer.hpp"
+
+#include <algorithm>
+
+void RewindBuffer::configure(int keyframe_interval, std::size_t budget_bytes)
+{
+    interval_ = std::max(keyframe_interval, 0);
+    budget_bytes_ = budget_bytes;
+    clear();
+}
+
+void RewindBuffer::clear()
+{
+    while (!keyframes_.empty())
+    {
+        dropKeyframe(std::move(keyframes_.back()));
+        keyframes_.pop_back();
+    }
+    dts_.clear();
+    base_step_ = 0;
+    bytes_ = 0;
+}
+
+void RewindBuffer::record(const Field& field, float dt)
+{
+    if (!enabled()) return;
+
+    // Anything other than the next step in sequence (a reset, a restore
+    // done elsewhere) starts the history over.
+    const uint64_t step = field.stepCount();
+    if (!keyframes_.empty() && step != newestStep())
+        clear();
+
+    if (keyframes_.empty())
+        base_step_ = step;
+    if (keyframes_.empty() || (step % interval_ == 0 && keyframes_.back().step != step))
+    {
+        Keyframe keyframe{step, std::move(spare_), 0};
+        field.captureKeyframe(keyframe.state);
+        keyframe.bytes = keyframe.state.bytes();
+        bytes_ += keyframe.bytes;
+        keyframes_.push_back(std::move(keyframe));
+    }
+
+    dts_.push_back(dt);
+    bytes_ += sizeof(float);
+    evictOverBudget();
+}
+
+bool RewindBuffer::seek(Field& field, uint64_t step)
+{
+    if (keyframes_.empty() || step < oldestStep() || step > newestStep())
+        return false;
+
+    // Newest keyframe at or before the target; at most interval_ - 1
+    // steps away from it.
+    auto it = std::upper_bound(keyframes_.begin(), keyframes_.end(), step,
+                               [](uint64_t s, const Keyframe& k) { return s < k.step; });
+    --it;
+    field.restoreKeyframe(it->state);
+
+    const bool muted = field.eventsMuted();
+    field.setEventsMuted(true); // these events were already reported the first time
+    for (uint64_t s = it->step; s < step; ++s)
+        field.step(dts_[s - base_step_]);
+    field.setEventsMuted(muted);
+
+    // Simulation resumes from here, so what came after is gone.
+    while (keyframes_.back().step > step)
+    {
+        dropKeyframe(std::move(keyframes_.back()));
+        keyframes_.pop_back();
+    }
+    const std::size_t keep = static_cast<std::size_t>(step - base_step_);
+    bytes_ -= (dts_.size() - keep) * sizeof(float);
+    dts_.resize(keep);
+    return true;
+}
+
+void RewindBuffer::evictOverBudget()
+{
+    // The newest keyframe always stays, so recent steps remain reachable
+    // even with a budget smaller than one keyframe.
+    while (bytes_ > budget_bytes_ && keyframes_.size() > 1)
+    {
+        const uint64_t next = keyframes_[1].step;
+        const std::size_t n = static_cast<std::size_t>(next - base_step_);
+        dts_.erase(dts_.begin(), dts_.begin() + n);
+        bytes_ -= n * sizeof(float);
+        base_step_ = next;
+
+        dropKeyframe(std::move(keyframes_.front()));
+        keyframes_.pop_front();
+    }
+}
+
+void RewindBuffer::dropKeyframe(Keyframe&& keyframe)
+{
+    bytes_ -= keyframe.bytes;
+    spare_ = std::move(keyframe.state);
+}
@@ -0,0 +1,68 @@
+//
+//  rewind_buffer.hpp
+//  Volterria
+//
+//  Created by Devin R Cohen on 10/18/26.
+//
+
+#pragma once
+
+// RewindBuffer: bounded in-memory history of a Field.
+// A full keyframe is taken every `keyframe_interval` steps; in between,
+// the only thing recorded is each step's dt, since with seeded random
+// streams a step is a pure function of (state, dt). Seeking restores the
+// nearest keyframe at or before the target and replays at most
+// keyframe_interval - 1 steps. When the history outgrows its budget the
+// oldest keyframe and its deltas are dropped.
+//
+// Replay uses the Field's current settings, so a seek past a settings
+// change re-runs those steps under the new values.
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+
+#include "field.hpp"
+
+class RewindBuffer
+{
+public:
+    // 0 for either argument turns history off.
+    void configure(int keyframe_interval, std::size_t budget_bytes);
+    void clear();
+    bool enabled() const noexcept { return interval_ > 0 && budget_bytes_ > 0; }
+
+    // Call right before field.step(dt).
+    void record(const Field& field, float dt);
+
+    // Put `field` back to the state it had after `step` steps, then forget
+    // everything recorded after it so simulation resumes from there.
+    // Returns false if the step isn't retained.
+    bool seek(Field& field, uint64_t step);
+
+    bool empty() const noexcept { return keyframes_.empty(); }
+    uint64_t oldestStep() const noexcept { return base_step_; }
+    uint64_t newestStep() const noexcept { return base_step_ + dts_.size(); }
+    std::size_t bytesInUse() const noexcept { return bytes_; }
+
+private:
+    struct Keyframe
+    {
+        uint64_t step;
+        FieldKeyframe state;
+        std::size_t bytes;
+    };
+
+    void evictOverBudget();
+    void dropKeyframe(Keyframe&& keyframe);
+
+    int interval_ = 0;
+    std::size_t budget_bytes_ = 0;
+
+    std::deque<Keyframe> keyframes_; // keyframes_.front().step == base_step_
+    std::deque<float> dts_;          // dts_[k] is the dt of step base_step_ + k
+    uint64_t base_step_ = 0;
+    std::size_t bytes_ = 0;
+
+    FieldKeyframe spare_; // last dropped keyframe, its buffers reused by the next capture
+};
@@ -11,6 +11,10 @@
 // This is intentionally free of any rendering library dependencies so that
 // the same code can be used on desktop (SFML) and on iOS (SwiftUI/SpriteKit).
 
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
 #include "constants.hpp"
 
 struct Settings
@@ -23,11 +27,12 @@ struct Settings
     float x_max = x_min + default_length/height_ratio;
     float y_min = 0.0f;
     float y_max = y_min + default_length;
-    const float x_center = (x_min + x_max)/2.0;
-    const float y_center = (y_min + y_max)/2.0;
+    // Derived from the bounds; recomputeDerived() brings them up to date.
+    float x_center = (x_min + x_max)/2.0;
+    float y_center = (y_min + y_max)/2.0;
     
-    const float field_width = x_max - x_min;
-    const float field_height = y_max - y_min;
+    float field_width = x_max - x_min;
+    float field_height = y_max - y_min;
     
     // spawn locations
     float prey_spawn_mean_x = x_center;
@@ -103,12 +108,33 @@ struct Settings
     float predator_vision_radius = 400.0f; // 300
     float interaction_multiplier = 2.f;
     float min_normalized_hunger_to_mate = 0.3f;
+    bool swept_interactions = true; // eat / mate on closest approach during the step, not just at its end
     //float cell_size = interaction_multiplier * interaction_radius;
-    const float cell_size = interaction_radius * interaction_multiplier;
-    
-    const float prey_max_speed = vmax_default / 1.0f; // 20% the speed of a predator so predator always wins, tune the denominator.
-    const float predator_max_speed = vmax_default;
+    float cell_size = interaction_radius * interaction_multiplier; // starting grid cell size (derived)
+    bool auto_cell_size = true; // let the Field retune the grid from density, radii and measured pair checks
+    int cell_retune_interval_steps = 120;
+    bool sparse_grid = false; // hash only occupied cells; for huge, sparsely populated worlds
+    bool neighbor_lists = false; // cache per-creature candidates at vision + skin, rebuilt only after real movement
+    float neighbor_skin = 20.0f; // lists are rebuilt once anyone moves half of this
+    int perception_interval_steps = 1; // each creature re-perceives every N steps, staggered by id
+    int perception_budget = 0; // if > 0, instead re-perceive this many creatures per step, round-robin
+    bool target_tracking = false; // keep chasing the same mate/grass while it stays valid instead of searching again
+    int target_refresh_steps = 15; // even a valid target is re-searched this often, so a closer one can win
+    bool event_timers = false; // hunger ticks, wander re-rolls and old age fire from a timing wheel, not per-creature accumulators
+    float timer_resolution = 1.0f / 120.0f; // seconds per timing-wheel tick
+    double mean_field_prey_capacity = 0.0; // prey carrying capacity for fast-forward; 0 = plain Lotka–Volterra
+    int mean_field_max_population = 10000; // fast-forward never materializes more than this many of a species
+    
+    float prey_max_speed = vmax_default / 1.0f; // 20% the speed of a predator so predator always wins, tune the denominator. (derived)
+    float predator_max_speed = vmax_default; // (derived)
     bool prevent_spirals = false; // causes females not to chase a mate if set true
+    bool batched_update = true; // CreatureKernel block update; false falls back to per-creature Creature::update
+    int worker_threads = 1; // threads for perception and the update; 1 = all on the calling thread
+    int tile_cells = 4; // perception is scheduled in tiles of tile_cells x tile_cells grid cells, weighted by occupancy
+    int tile_max_creatures = 256; // heavier tiles are split, so one crowded cell can't hold up a whole phase
+    bool numa_tiles = false; // pin workers per NUMA node; each node owns an x strip of tiles, and their creatures' storage once the reorder runs
+    bool segregate_species = true; // the reorder (when on) also groups creatures by species, so update blocks take the single-species path
+    int reorder_interval_steps = 0; // re-sort creature storage along a Z-order curve every N steps, 0 = never (changes iteration order)
     // Aging parameters
     float prey_max_age = 30.f; // seconds in-game time: 60f latest default
     //float prey_age_tolerance = 2.f; // +/- seconds
@@ -126,14 +152,51 @@ struct Settings
     float grass_radius_frac = 0.5f; // fraction of cell size to be used as radius
     float grass_eat_rate = 4.0f;
     float min_grass_edible_health = 0.f; // prey can't eat until patch is this healthy
+    bool grass_raster = false; // dense grass grid aligned to the spatial grid instead of patches
+    int grass_raster_subdivisions = 4; // raster cells per side of a grid cell, when the raster is laid out
+    float grass_diffusion_rate = 0.0f; // per second: how fast raster grass spreads to neighboring cells, 0 = off
     
     
     // Sex
     float probability_female_prey = 0.5f;
     float probability_female_pred = 0.5f;
     
-    const int num_cells_x = std::ceil((x_max - x_min) / cell_size);
-    const int num_cells_y = std::ceil((y_max - y_min) / cell_size);
-    
-    
+    // Random streams. 0 seeds from std::random_device on every reset;
+    // anything else makes runs reproducible.
+    uint64_t rng_seed = 0;
+    
+    // Rewind history (VolterriaEngine): a full keyframe every N steps plus
+    // each step's dt in between. 0 MB keeps no history.
+    int history_keyframe_interval = 120;
+    int history_budget_mb = 0;
+    
+    int num_cells_x = std::ceil((x_max - x_min) / cell_size); // (derived)
+    int num_cells_y = std::ceil((y_max - y_min) / cell_size); // (derived)
+    
+    // Bring the derived members up to date with the fields they are
+    // computed from, after the bounds, radii or vmax have changed.
+    void recomputeDerived()
+    {
+        x_center = (x_min + x_max)/2.0;
+        y_center = (y_min + y_max)/2.0;
+        field_width = x_max - x_min;
+        field_height = y_max - y_min;
+        cell_size = interaction_radius * interaction_multiplier;
+        prey_max_speed = vmax_default / 1.0f;
+        predator_max_speed = vmax_default;
+        num_cells_x = std::ceil((x_max - x_min) / cell_size);
+        num_cells_y = std::ceil((y_max - y_min) / cell_size);
+    }
+    
+    // Put the spawn distributions back to their defaults for the current
+    // bounds (same placement as a fresh Settings, same stdev_n).
+    void recenterSpawns()
+    {
+        prey_spawn_mean_x = x_center;
+        prey_spawn_mean_y = (y_min + y_center) / 2.0;
+        prey_spawn_stdev = std::min(field_height/2.0, field_height/2.0) / (2 * prey_spawn_stdev_n);
+        predator_spawn_mean_x = x_center;
+        predator_spawn_mean_y = (y_center + y_max) / 2.0;
+        predator_spawn_stdev = std::min(field_height/2.0, field_height/2.0) / (2 * predator_spawn_stdev_n);
+    }
 };
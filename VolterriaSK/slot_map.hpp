@@ -0,0 +1,236 @@
+//
+//  slot_map.hpp
+//  Volterria
+//
+//  Created by Devin R Cohen on 10/18/26.
+//
+
+#pragma once
+
+// SlotMap: dense storage with stable generational handles.
+// Values live contiguously (so per-frame loops stay linear), while a
+// separate slot table maps each handle to wherever its value currently
+// sits. Erasing swaps the last value into the hole, so removal is O(1)
+// and never compacts the whole array. Freed slots are recycled through a
+// free list with their generation bumped, so stale handles stop resolving.
+//
+// Limits of the packed handle: at most 2^20 slots (emplace() throws
+// std::length_error past that rather than hand out an index that would
+// spill into the generation bits), and the generation wraps after 2047
+// frees of one slot. The free list is LIFO, so the busiest slots get there
+// first; a handle held across that many reuses of its slot can resolve to
+// an unrelated value again. Handles are ids for the living, not a
+// permanent history.
+
+#include <cstdint>
+#include <cstddef>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+struct SlotHandle
+{
+    // Packed into 31 bits so the handle doubles as a positive Int32 id
+    // on the Swift side: 20 bits of slot index, 11 bits of generation.
+    static constexpr uint32_t kIndexBits      = 20;
+    static constexpr uint32_t kGenerationBits = 11;
+    static constexpr uint32_t kIndexMask      = (1u << kIndexBits) - 1;
+    static constexpr uint32_t kGenerationMask = (1u << kGenerationBits) - 1;
+    static constexpr uint32_t kMaxSlots       = 1u << kIndexBits;
+
+    uint32_t index      = 0;
+    uint32_t generation = 0; // 0 is never handed out, so a default handle is null
+
+    bool valid() const noexcept { return generation != 0; }
+    uint32_t packed() const noexcept { return (generation << kIndexBits) | index; }
+
+    static SlotHandle fromPacked(uint32_t id) noexcept
+    {
+        return { id & kIndexMask, (id >> kIndexBits) & kGenerationMask };
+    }
+
+    friend bool operator==(SlotHandle a, SlotHandle b) noexcept
+    {
+        return a.index == b.index && a.generation == b.generation;
+    }
+    friend bool operator!=(SlotHandle a, SlotHandle b) noexcept { return !(a == b); }
+};
+
+template <typename T>
+class SlotMap
+{
+public:
+    static constexpr uint32_t kNone = 0xFFFFFFFFu;
+
+    // Handle the next emplace() will return. Lets a value embed its own
+    // id before it is constructed.
+    SlotHandle peekHandle() const noexcept
+    {
+        if (free_head_ != kNone) return { free_head_, slots_[free_head_].generation };
+        return { static_cast<uint32_t>(slots_.size()), 1 };
+    }
+
+    template <typename... Args>
+    SlotHandle emplace(Args&&... args)
+    {
+        uint32_t slot;
+        if (free_head_ != kNone)
+        {
+            slot = free_head_;
+            free_head_ = slots_[slot].next_free;
+        }
+        else
+        {
+            if (slots_.size() >= SlotHandle::kMaxSlots)
+                throw std::length_error("SlotMap: out of slot indices (2^20)");
+            slot = static_cast<uint32_t>(slots_.size());
+            slots_.push_back({kNone, 1, kNone});
+        }
+        values_.emplace_back(std::forward<Args>(args)...);
+        dense_to_slot_.push_back(slot);
+        slots_[slot].dense = static_cast<uint32_t>(values_.size() - 1);
+        return { slot, slots_[slot].generation };
+    }
+
+    // Remove the value at dense position i by moving the last value into it.
+    void eraseAt(std::size_t i)
+    {
+        const uint32_t slot = dense_to_slot_[i];
+        const std::size_t last = values_.size() - 1;
+        if (i != last)
+        {
+            values_[i] = std::move(values_[last]);
+            dense_to_slot_[i] = dense_to_slot_[last];
+            slots_[dense_to_slot_[i]].dense = static_cast<uint32_t>(i);
+        }
+        values_.pop_back();
+        dense_to_slot_.pop_back();
+        freeSlot(slot);
+    }
+
+    bool erase(SlotHandle h)
+    {
+        const int i = denseIndex(h);
+        if (i < 0) return false;
+        eraseAt(static_cast<std::size_t>(i));
+        return true;
+    }
+
+    // O(1) handle -> dense position; -1 if the handle is stale.
+    int denseIndex(SlotHandle h) const noexcept
+    {
+        if (h.index >= slots_.size()) return -1;
+        const Slot& s = slots_[h.index];
+        if (s.generation != h.generation || s.dense == kNone) return -1;
+        return static_cast<int>(s.dense);
+    }
+
+    bool contains(SlotHandle h) const noexcept { return denseIndex(h) >= 0; }
+
+    T* get(SlotHandle h) noexcept
+    {
+        const int i = denseIndex(h);
+        return i < 0 ? nullptr : &values_[i];
+    }
+
+    const T* get(SlotHandle h) const noexcept
+    {
+        const int i = denseIndex(h);
+        return i < 0 ? nullptr : &values_[i];
+    }
+
+    SlotHandle handleAt(std::size_t i) const noexcept
+    {
+        const uint32_t slot = dense_to_slot_[i];
+        return { slot, slots_[slot].generation };
+    }
+
+    // Reorder the dense storage: new position k takes the value that was at
+    // order[k]. Handles are unaffected. The previous buffer is kept as
+    // scratch, so repeated reorders don't allocate once warmed up.
+    template <typename Index>
+    void permute(const Index* order)
+    {
+        const std::size_t n = values_.size();
+        scratch_.clear();
+        scratch_.reserve(n);
+        scratch_dense_to_slot_.resize(n);
+        for (std::size_t k = 0; k < n; ++k)
+        {
+            const std::size_t from = static_cast<std::size_t>(order[k]);
+            scratch_.push_back(std::move(values_[from]));
+            scratch_dense_to_slot_[k] = dense_to_slot_[from];
+            slots_[dense_to_slot_[from]].dense = static_cast<uint32_t>(k);
+        }
+        values_.swap(scratch_);
+        dense_to_slot_.swap(scratch_dense_to_slot_);
+        scratch_.clear();
+    }
+
+    // Drop every value but keep the slot table, so handles issued before
+    // the clear don't alias the ones issued after it (short of the wrap).
+    void clear()
+    {
+        for (uint32_t slot : dense_to_slot_)
+            freeSlot(slot);
+        values_.clear();
+        dense_to_slot_.clear();
+    }
+
+    void reserve(std::size_t n)
+    {
+        values_.reserve(n);
+        dense_to_slot_.reserve(n);
+        slots_.reserve(n);
+    }
+
+    std::size_t size()  const noexcept { return values_.size(); }
+    bool        empty() const noexcept { return values_.empty(); }
+    std::size_t slotCount() const noexcept { return slots_.size(); } // bound on SlotHandle::index
+
+    // Heap bytes held by the map (capacity, not size); scratch excluded.
+    std::size_t bytes() const noexcept
+    {
+        return values_.capacity() * sizeof(T)
+             + dense_to_slot_.capacity() * sizeof(uint32_t)
+             + slots_.capacity() * sizeof(Slot);
+    }
+
+    T&       operator[](std::size_t i)       noexcept { return values_[i]; }
+    const T& operator[](std::size_t i) const noexcept { return values_[i]; }
+
+    T*       data()       noexcept { return values_.data(); }
+    const T* data() const noexcept { return values_.data(); }
+    const std::vector<T>& values() const noexcept { return values_; }
+
+    auto begin()       noexcept { return values_.begin(); }
+    auto end()         noexcept { return values_.end(); }
+    auto begin() const noexcept { return values_.begin(); }
+    auto end()   const noexcept { return values_.end(); }
+
+private:
+    struct Slot
+    {
+        uint32_t dense;      // position in values_, kNone while free
+        uint32_t generation; // bumped on every free
+        uint32_t next_free;
+    };
+
+    void freeSlot(uint32_t slot)
+    {
+        Slot& s = slots_[slot];
+        s.dense = kNone;
+        s.generation = (s.generation + 1) & SlotHandle::kGenerationMask;
+        if (s.generation == 0) s.generation = 1;
+        s.next_free = free_head_;
+        free_head_ = slot;
+    }
+
+    std::vector<T>        values_;
+    std::vector<uint32_t> dense_to_slot_;
+    std::vector<Slot>     slots_;
+    uint32_t              free_head_ = kNone;
+
+    std::vector<T>        scratch_; // spare buffers for permute()
+    std::vector<uint32_t> scratch_dense_to_slot_;
+};
@@ -0,0 +1,251 @@
+//
+//  snapshot_shm.cpp
+//  Volterria
+//
+//  Created by Devin R Cohen on 10/18/26.
+//
+
+#include "snapshot_shm.hpp"
+#include "VolterriaEngine.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+#include <new>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace
+{
+    // shm_open wants a leading slash; accept names without one.
+    std::string segmentName(const std::string& name)
+    {
+        return (!name.empty() && name[0] == '/') ? name : "/" + name;
+    }
+
+    constexpr std::size_t alignUp(std::size_t n, std::size_t a = 64)
+    {
+        return (n + a - 1) / a * a;
+    }
+
+    // Records start on cache-line boundaries after the header.
+    struct Layout
+    {
+        std::size_t creatures_offset;
+        std::size_t grass_offset;
+        std::size_t bytes;
+    };
+
+    Layout layoutFor(std::size_t creature_capacity, std::size_t grass_capacity)
+    {
+        Layout l;
+        l.creatures_offset = alignUp(sizeof(SnapshotShmHeader));
+        l.grass_offset = alignUp(l.creatures_offset + creature_capacity * sizeof(VCreatureSnapshot));
+        l.bytes = alignUp(l.grass_offset + grass_capacity * sizeof(VGrassPatchSnapshot));
+        return l;
+    }
+}
+
+std::shared_ptr<SnapshotPublisher> SnapshotPublisher::create(const std::string& name,
+                                                             std::size_t creature_capacity,
+                                                             std::size_t grass_capacity)
+{
+    const std::string shm = segmentName(name);
+    const Layout layout = layoutFor(creature_capacity, grass_capacity);
+
+    // Replace any stale segment of the same name rather than resizing it
+    // under readers that still have the old one mapped.
+    shm_unlink(shm.c_str());
+    const int fd = shm_open(shm.c_str(), O_CREAT | O_EXCL | O_RDWR, 0644);
+    if (fd < 0)
+    {
+        std::cerr << "shm_open(" << shm << ") failed: " << std::strerror(errno) << "\n";
+        return nullptr;
+    }
+    if (ftruncate(fd, static_cast<off_t>(layout.bytes)) != 0)
+    {
+        std::cerr << "ftruncate(" << shm << ") failed: " << std::strerror(errno) << "\n";
+        close(fd);
+        shm_unlink(shm.c_str());
+        return nullptr;
+    }
+    struct stat st;
+    const bool identified = fstat(fd, &st) == 0;
+    void* base = mmap(nullptr, layout.bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (base == MAP_FAILED)
+    {
+        std::cerr << "mmap(" << shm << ") failed: " << std::strerror(errno) << "\n";
+        shm_unlink(shm.c_str());
+        return nullptr;
+    }
+
+    std::shared_ptr<SnapshotPublisher> p(new SnapshotPublisher());
+    p->name_ = shm;
+    if (identified)
+    {
+        p->device_ = static_cast<uint64_t>(st.st_dev);
+        p->inode_ = static_cast<uint64_t>(st.st_ino);
+    }
+    p->base_ = base;
+    p->bytes_ = layout.bytes;
+
+    auto* bytes = static_cast<std::byte*>(base);
+    p->header_ = new (base) SnapshotShmHeader();
+    p->creatures_ = reinterpret_cast<VCreatureSnapshot*>(bytes + layout.creatures_offset);
+    p->grass_ = reinterpret_cast<VGrassPatchSnapshot*>(bytes + layout.grass_offset);
+
+    SnapshotShmHeader& h = *p->header_;
+    h.creature_record_size = sizeof(VCreatureSnapshot);
+    h.grass_record_size = sizeof(VGrassPatchSnapshot);
+    h.creature_capacity = static_cast<uint32_t>(creature_capacity);
+    h.grass_capacity = static_cast<uint32_t>(grass_capacity);
+    h.version = SnapshotShmHeader::kVersion;
+    // Readers check the magic last-written, so a half-initialized header
+    // is never mistaken for a valid one.
+    std::atomic_thread_fence(std::memory_order_release);
+    h.magic = SnapshotShmHeader::kMagic;
+    return p;
+}
+
+SnapshotPublisher::~SnapshotPublisher()
+{
+    if (!base_) return;
+    munmap(base_, bytes_);
+
+    // A later create() under the same name replaces the segment while this
+    // publisher may still be alive; only unlink the name if it is still ours.
+    const int fd = shm_open(name_.c_str(), O_RDONLY, 0);
+    if (fd < 0) return;
+    struct stat st;
+    const bool ours = fstat(fd, &st) == 0 && inode_ != 0 &&
+                      static_cast<uint64_t>(st.st_dev) == device_ &&
+                      static_cast<uint64_t>(st.st_ino) == inode_;
+    close(fd);
+    if (ours)
+        shm_unlink(name_.c_str());
+}
+
+void SnapshotPublisher::publish(const std::vector<VCreatureSnapshot>& creatures,
+                                const std::vector<VGrassPatchSnapshot>& grass,
+                                uint64_t step, double sim_time)
+{
+    SnapshotShmHeader& h = *header_;
+    const std::size_t nc = std::min<std::size_t>(creatures.size(), h.creature_capacity);
+    const std::size_t ng = std::min<std::size_t>(grass.size(), h.grass_capacity);
+
+    const uint64_t seq = h.sequence.load(std::memory_order_relaxed);
+    h.sequence.store(seq + 1, std::memory_order_relaxed); // odd: frame in progress
+    std::atomic_thread_fence(std::memory_order_release);
+
+    std::memcpy(creatures_, creatures.data(), nc * sizeof(VCreatureSnapshot));
+    std::memcpy(grass_, grass.data(), ng * sizeof(VGrassPatchSnapshot));
+    h.creature_count = static_cast<uint32_t>(nc);
+    h.grass_count = static_cast<uint32_t>(ng);
+    h.truncated = (nc < creatures.size() || ng < grass.size()) ? 1 : 0;
+    h.step = step;
+    h.sim_time = sim_time;
+
+    h.sequence.store(seq + 2, std::memory_order_release);
+    ++frames_;
+}
+
+std::unique_ptr<SnapshotReader> SnapshotReader::open(const std::string& name)
+{
+    const std::string shm = segmentName(name);
+    const int fd = shm_open(shm.c_str(), O_RDONLY, 0);
+    if (fd < 0)
+    {
+        std::cerr << "shm_open(" << shm << ") failed: " << std::strerror(errno) << "\n";
+        return nullptr;
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0 || static_cast<std::size_t>(st.st_size) < sizeof(SnapshotShmHeader))
+    {
+        std::cerr << shm << " is not a snapshot segment\n";
+        close(fd);
+        return nullptr;
+    }
+    const std::size_t bytes = static_cast<std::size_t>(st.st_size);
+    void* base = mmap(nullptr, bytes, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (base == MAP_FAILED)
+    {
+        std::cerr << "mmap(" << shm << ") failed: " << std::strerror(errno) << "\n";
+        return nullptr;
+    }
+
+    const auto* h = static_cast<const SnapshotShmHeader*>(base);
+    const bool valid = h->magic == SnapshotShmHeader::kMagic
+                    && h->version == SnapshotShmHeader::kVersion
+                    && h->creature_record_size == sizeof(VCreatureSnapshot)
+                    && h->grass_record_size == sizeof(VGrassPatchSnapshot);
+    const Layout layout = valid ? layoutFor(h->creature_capacity, h->grass_capacity) : Layout{};
+    if (!valid || layout.bytes > bytes)
+    {
+        std::cerr << shm << " has an incompatible layout\n";
+        munmap(base, bytes);
+        return nullptr;
+    }
+
+    std::unique_ptr<SnapshotReader> r(new SnapshotReader());
+    const auto* raw = static_cast<const std::byte*>(base);
+    r->base_ = base;
+    r->bytes_ = bytes;
+    r->header_ = h;
+    r->creatures_ = reinterpret_cast<const VCreatureSnapshot*>(raw + layout.creatures_offset);
+    r->grass_ = reinterpret_cast<const VGrassPatchSnapshot*>(raw + layout.grass_offset);
+    return r;
+}
+
+SnapshotReader::~SnapshotReader()
+{
+    if (base_)
+        munmap(const_cast<void*>(base_), bytes_);
+}
+
+uint64_t SnapshotReader::beginRead() const noexcept
+{
+    return header_->sequence.load(std::memory_order_acquire);
+}
+
+bool SnapshotReader::validate(uint64_t sequence) const noexcept
+{
+    std::atomic_thread_fence(std::memory_order_acquire);
+    return (sequence & 1) == 0 && header_->sequence.load(std::memory_order_relaxed) == sequence;
+}
+
+bool SnapshotReader::read(std::vector<VCreatureSnapshot>& creatures,
+                          std::vector<VGrassPatchSnapshot>& grass,
+                          uint64_t* step, double* sim_time, int max_attempts) const
+{
+    for (int attempt = 0; attempt < max_attempts; ++attempt)
+    {
+        const uint64_t seq = beginRead();
+        if (seq == 0) return false; // nothing published yet
+        if (seq & 1) continue;      // writer is mid-frame
+
+        // Counts may be torn if the writer started over; clamp before
+        // copying and let validate() throw the frame away.
+        const std::size_t nc = std::min(header_->creature_count, header_->creature_capacity);
+        const std::size_t ng = std::min(header_->grass_count, header_->grass_capacity);
+        creatures.resize(nc);
+        grass.resize(ng);
+        std::memcpy(creatures.data(), creatures_, nc * sizeof(VCreatureSnapshot));
+        std::memcpy(grass.data(), grass_, ng * sizeof(VGrassPatchSnapshot));
+        const uint64_t frame_step = header_->step;
+        const double frame_time = header_->sim_time;
+
+        if (validate(seq))
+        {
+            if (step) *step = frame_step;
+            if (sim_time) *sim_time = frame_time;
+            return true;
+        }
+    }
+    return false;
+}
@@ -0,0 +1,129 @@
+//
+//  snapshot_shm.hpp
+//  Volterria
+//
+//  Created by Devin R Cohen on 10/18/26.
+//
+
+#pragma once
+
+// Snapshot frames in POSIX shared memory, for viewers and analysis tools
+// running as separate processes on the same host.
+//
+// The segment is a fixed-size header followed by room for up to
+// creature_capacity VCreatureSnapshot and grass_capacity
+// VGrassPatchSnapshot records. One writer (the simulation) and any number
+// of readers coordinate through a seqlock: the writer bumps the sequence
+// to odd, rewrites the frame, then bumps it back to even. It never waits
+// for anyone. Readers copy (or read in place) between two loads of the
+// sequence and retry if it was odd or changed.
+//
+// Capacity is fixed when the segment is created, since readers have it
+// mapped; a population larger than that is truncated and flagged.
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+struct VCreatureSnapshot;
+struct VGrassPatchSnapshot;
+
+struct SnapshotShmHeader
+{
+    static constexpr uint32_t kMagic   = 0x564F4C54; // "VOLT"
+    static constexpr uint32_t kVersion = 1;
+
+    uint32_t magic;
+    uint32_t version;
+    uint32_t creature_record_size; // sizeof(VCreatureSnapshot) on the writer
+    uint32_t grass_record_size;
+    uint32_t creature_capacity;
+    uint32_t grass_capacity;
+
+    std::atomic<uint64_t> sequence; // odd while a frame is being written
+
+    // Frame fields, only meaningful under an even, unchanged sequence.
+    uint32_t creature_count;
+    uint32_t grass_count;
+    uint32_t truncated;             // 1 if the population didn't fit
+    uint32_t reserved;
+    uint64_t step;
+    double   sim_time;
+};
+
+static_assert(std::atomic<uint64_t>::is_always_lock_free,
+              "the seqlock must be address-free to work across processes");
+
+// Writer side. Creates (or replaces) the named segment and unlinks it on
+// destruction, unless the name has since been taken by a newer segment.
+class SnapshotPublisher
+{
+public:
+    // nullptr if the segment couldn't be created or mapped.
+    static std::shared_ptr<SnapshotPublisher> create(const std::string& name,
+                                                     std::size_t creature_capacity,
+                                                     std::size_t grass_capacity);
+    ~SnapshotPublisher();
+
+    SnapshotPublisher(const SnapshotPublisher&) = delete;
+    SnapshotPublisher& operator=(const SnapshotPublisher&) = delete;
+
+    void publish(const std::vector<VCreatureSnapshot>& creatures,
+                 const std::vector<VGrassPatchSnapshot>& grass,
+                 uint64_t step, double sim_time);
+
+    const std::string& name() const noexcept { return name_; }
+    uint64_t framesPublished() const noexcept { return frames_; }
+
+private:
+    SnapshotPublisher() = default;
+
+    std::string name_;
+    uint64_t device_ = 0; // identify our segment, so the destructor
+    uint64_t inode_ = 0;  // doesn't unlink a replacement
+    void* base_ = nullptr;
+    std::size_t bytes_ = 0;
+    SnapshotShmHeader* header_ = nullptr;
+    VCreatureSnapshot* creatures_ = nullptr;
+    VGrassPatchSnapshot* grass_ = nullptr;
+    uint64_t frames_ = 0;
+};
+
+// Reader side. Maps an existing segment read-only.
+class SnapshotReader
+{
+public:
+    static std::unique_ptr<SnapshotReader> open(const std::string& name);
+    ~SnapshotReader();
+
+    SnapshotReader(const SnapshotReader&) = delete;
+    SnapshotReader& operator=(const SnapshotReader&) = delete;
+
+    // Copy out the latest complete frame. Returns false if the writer kept
+    // overwriting it for max_attempts tries, or nothing was published yet.
+    bool read(std::vector<VCreatureSnapshot>& creatures,
+              std::vector<VGrassPatchSnapshot>& grass,
+              uint64_t* step = nullptr, double* sim_time = nullptr,
+              int max_attempts = 16) const;
+
+    // Zero-copy access: take beginRead(), read the records in place, and
+    // only trust what you read if validate() returns true for the same
+    // sequence.
+    uint64_t beginRead() const noexcept;
+    bool validate(uint64_t sequence) const noexcept;
+    const SnapshotShmHeader& header() const noexcept { return *header_; }
+    const VCreatureSnapshot* creatures() const noexcept { return creatures_; }
+    const VGrassPatchSnapshot* grass() const noexcept { return grass_; }
+
+private:
+    SnapshotReader() = default;
+
+    const void* base_ = nullptr;
+    std::size_t bytes_ = 0;
+    const SnapshotShmHeader* header_ = nullptr;
+    const VCreatureSnapshot* creatures_ = nullptr;
+    const VGrassPatchSnapshot* grass_ = nullptr;
+};
@@ -0,0 +1,106 @@
+//
+//  species_policy.hpp
+//  Volterria
+//
+//  Created by Devin R Cohen on 10/18/26.
+//
+
+#pragma once
+
+// SpeciesPolicy<R>: everything that differs between prey and predators,
+// resolved by type instead of by checking species() on every creature.
+// The hot loops (Creature::update, the batched kernel, perception) branch
+// on species once per creature or block and then run code specialized
+// for that species: which Settings fields hold its thresholds and speeds
+// is fixed at compile time, and behavior that only one species has
+// (grazing) compiles out of the other's path entirely.
+//
+// Settings are still runtime values, so the thresholds themselves are
+// loop invariants rather than constants; what goes away is the per-
+// creature selection between two sets of them.
+
+#include "creature.hpp"
+#include "settings.hpp"
+
+// One species' update parameters, as the batched kernel consumes them.
+struct SpeciesParams
+{
+    float hunger_threshold;
+    float libido_threshold;
+    float food_speed_min;
+    float food_speed_max;
+    float food_max_accel;
+    float mate_speed_min;
+    float mate_speed_max;
+    float mate_max_accel;
+    float starve_rate;
+    float libido_rate;
+    float libido_max;
+};
+
+template <SpeciesRole R>
+struct SpeciesPolicy;
+
+template <>
+struct SpeciesPolicy<SpeciesRole::Prey>
+{
+    static constexpr SpeciesRole role = SpeciesRole::Prey;
+    static constexpr bool grazes = true; // hungry prey steer for grass patches
+
+    static float hungerThreshold(const Settings& s) noexcept { return s.prey_hunger_threshold; }
+    static float libidoThreshold(const Settings& s) noexcept { return s.prey_libido_threshold; }
+    static float visionRadius(const Settings& s)    noexcept { return s.prey_vision_radius; }
+    static float foodSpeedMin(const Settings& s)    noexcept { return s.prey_forage_speed_min; }
+    static float foodSpeedMax(const Settings& s)    noexcept { return s.prey_forage_speed_max; }
+    static float foodMaxAccel(const Settings& s)    noexcept { return s.prey_forage_max_accel; }
+    static float mateSpeedMin(const Settings& s)    noexcept { return s.prey_mate_speed_min; }
+    static float mateSpeedMax(const Settings& s)    noexcept { return s.prey_mate_speed_max; }
+    static float mateMaxAccel(const Settings& s)    noexcept { return s.prey_mate_max_accel; }
+    static float starveRate(const Settings& s)      noexcept { return s.prey_starve_rate; }
+    static float libidoRate(const Settings& s)      noexcept { return s.prey_libido_rate; }
+    static float libidoMax(const Settings& s)       noexcept { return s.prey_libido_max; }
+    static float hungerMax(const Settings& s)       noexcept { return s.prey_hunger_max; }
+    static float maxAge(const Settings& s)          noexcept { return s.prey_max_age; }
+};
+
+template <>
+struct SpeciesPolicy<SpeciesRole::Predator>
+{
+    static constexpr SpeciesRole role = SpeciesRole::Predator;
+    static constexpr bool grazes = false;
+
+    static float hungerThreshold(const Settings& s) noexcept { return s.pred_hunger_threshold; }
+    static float libidoThreshold(const Settings& s) noexcept { return s.pred_libido_threshold; }
+    static float visionRadius(const Settings& s)    noexcept { return s.predator_vision_radius; }
+    static float foodSpeedMin(const Settings& s)    noexcept { return s.predator_hunt_speed_min; }
+    static float foodSpeedMax(const Settings& s)    noexcept { return s.predator_hunt_speed_max; }
+    static float foodMaxAccel(const Settings& s)    noexcept { return s.predator_hunt_max_accel; }
+    static float mateSpeedMin(const Settings& s)    noexcept { return s.predator_mate_speed_min; }
+    static float mateSpeedMax(const Settings& s)    noexcept { return s.predator_mate_speed_max; }
+    static float mateMaxAccel(const Settings& s)    noexcept { return s.predator_mate_max_accel; }
+    static float starveRate(const Settings& s)      noexcept { return s.pred_starve_rate; }
+    static float libidoRate(const Settings& s)      noexcept { return s.pred_libido_rate; }
+    static float libidoMax(const Settings& s)       noexcept { return s.predator_libido_max; }
+    static float hungerMax(const Settings& s)       noexcept { return s.predator_hunger_max; }
+    static float maxAge(const Settings& s)          noexcept { return s.pred_max_age; }
+};
+
+template <SpeciesRole R>
+inline SpeciesParams speciesParams(const Settings& s) noexcept
+{
+    using P = SpeciesPolicy<R>;
+    return { P::hungerThreshold(s), P::libidoThreshold(s),
+             P::foodSpeedMin(s), P::foodSpeedMax(s), P::foodMaxAccel(s),
+             P::mateSpeedMin(s), P::mateSpeedMax(s), P::mateMaxAccel(s),
+             P::starveRate(s), P::libidoRate(s), P::libidoMax(s) };
+}
+
+// Call fn(SpeciesPolicy<R>{}) for the runtime species `role`; the one
+// place a species value turns back into a type.
+template <typename Fn>
+inline decltype(auto) withSpecies(SpeciesRole role, Fn&& fn)
+{
+    if (role == SpeciesRole::Prey)
+        return fn(SpeciesPolicy<SpeciesRole::Prey>{});
+    return fn(SpeciesPolicy<SpeciesRole::Predator>{});
+}
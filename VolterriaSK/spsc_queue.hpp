@@ -0,0 +1,89 @@
+//
+//  spsc_queue.hpp
+//  Volterria
+//
+//  Created by Devin R Cohen on 10/18/26.
+//
+
+#pragma once
+
+// Bounded single-producer / single-consumer ring buffer.
+// The simulation thread pushes, one reader (UI, logger thread) pops.
+// Neither side ever blocks: a push into a full queue is dropped and
+// counted instead of waiting on the reader.
+
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+template <typename T>
+class SpscQueue
+{
+public:
+    // Capacity is rounded up to a power of two.
+    explicit SpscQueue(std::size_t capacity)
+    {
+        std::size_t n = 2;
+        while (n < capacity) n <<= 1;
+        buffer_.resize(n);
+        mask_ = n - 1;
+    }
+
+    SpscQueue(const SpscQueue&) = delete;
+    SpscQueue& operator=(const SpscQueue&) = delete;
+
+    // Producer side.
+    bool tryPush(const T& value) noexcept
+    {
+        const std::size_t tail = tail_.load(std::memory_order_relaxed);
+        if (tail - cached_head_ > mask_)
+        {
+            cached_head_ = head_.load(std::memory_order_acquire);
+            if (tail - cached_head_ > mask_)
+            {
+                dropped_.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            }
+        }
+        buffer_[tail & mask_] = value;
+        tail_.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer side.
+    bool tryPop(T& out) noexcept
+    {
+        const std::size_t head = head_.load(std::memory_order_relaxed);
+        if (head == cached_tail_)
+        {
+            cached_tail_ = tail_.load(std::memory_order_acquire);
+            if (head == cached_tail_)
+                return false;
+        }
+        out = buffer_[head & mask_];
+        head_.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    std::size_t capacity() const noexcept { return mask_ + 1; }
+    std::size_t dropped()  const noexcept { return dropped_.load(std::memory_order_relaxed); }
+
+    // Approximate; exact only when called from one of the two sides while
+    // the other is idle.
+    std::size_t sizeApprox() const noexcept
+    {
+        return tail_.load(std::memory_order_acquire) - head_.load(std::memory_order_acquire);
+    }
+
+private:
+    std::vector<T> buffer_;
+    std::size_t    mask_ = 0;
+
+    // Producer and consumer indices on separate cache lines so the two
+    // threads don't false-share.
+    alignas(64) std::atomic<std::size_t> tail_{0};
+    std::size_t cached_head_ = 0; // producer's last view of head_
+    alignas(64) std::atomic<std::size_t> head_{0};
+    std::size_t cached_tail_ = 0; // consumer's last view of tail_
+    alignas(64) std::atomic<std::size_t> dropped_{0};
+};
@@ -0,0 +1,205 @@
+//
+//  tile_scheduler.cpp
+//  Volterria
+//
+//  Created by Devin R Cohen on 10/18/26.
+//
+
+#include "tile_scheduler.hpp"
+
+#include <algorithm>
+#include <numeric>
+
+TileScheduler::TileScheduler(int workers, const NumaTopology* numa)
+    : numa_(numa != nullptr),
+      topology_(numa ? *numa : NumaTopology{}),
+      nodes_(numa ? std::clamp(numa->nodes(), 1, std::max(workers, 1)) : 1),
+      worker_node_(std::max(workers, 1)),
+      queues_(std::max(workers, 1)),
+      load_(queues_.size()),
+      node_load_(nodes_)
+{
+    // Contiguous groups, so each node gets its fair share of workers.
+    for (int w = 0; w < this->workers(); ++w)
+        worker_node_[w] = w * nodes_ / this->workers();
+    for (int w = 1; w < this->workers(); ++w)
+        threads_.emplace_back(&TileScheduler::workerLoop, this, w);
+}
+
+TileScheduler::~TileScheduler()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    start_.notify_all();
+    for (std::thread& t : threads_)
+        t.join();
+}
+
+void TileScheduler::run(const std::vector<uint32_t>& weights, TaskFn fn,
+                        const std::vector<uint16_t>* homes)
+{
+    const std::size_t n = weights.size();
+    steals_.store(0, std::memory_order_relaxed);
+    std::fill(node_load_.begin(), node_load_.end(), NodeLoad{});
+    for (Queue& q : queues_)
+        q.done = NodeLoad{};
+    if (n == 0) return;
+
+    job_ = &fn;
+    weights_ = &weights;
+    homes_ = homes;
+    if (workers() == 1 || n == 1)
+    {
+        for (std::size_t t = 0; t < n; ++t)
+            runTask(0, static_cast<uint32_t>(t));
+        node_load_[worker_node_[0]] = queues_[0].done;
+        job_ = nullptr;
+        return;
+    }
+
+    // Heaviest first, each to the least loaded worker so far (on its home
+    // node, when it has one).
+    order_.resize(n);
+    std::iota(order_.begin(), order_.end(), 0u);
+    std::sort(order_.begin(), order_.end(), [&](uint32_t a, uint32_t b)
+    {
+        return weights[a] != weights[b] ? weights[a] > weights[b] : a < b; // stable, without a buffer
+    });
+    for (Queue& q : queues_)
+        q.tasks.clear();
+    std::fill(load_.begin(), load_.end(), 0);
+    for (uint32_t t : order_)
+    {
+        std::size_t w = 0;
+        if (homes)
+        {
+            const int home = (*homes)[t] % nodes_;
+            uint64_t best = UINT64_MAX;
+            for (std::size_t v = 0; v < load_.size(); ++v)
+            {
+                if (worker_node_[v] == home && load_[v] < best)
+                {
+                    best = load_[v];
+                    w = v;
+                }
+            }
+        }
+        else
+        {
+            w = std::min_element(load_.begin(), load_.end()) - load_.begin();
+        }
+        queues_[w].tasks.push_back(t);
+        load_[w] += std::max<uint32_t>(weights[t], 1);
+    }
+    for (Queue& q : queues_)
+        q.bounds.store(pack(0, static_cast<uint32_t>(q.tasks.size())), std::memory_order_release);
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        ++generation_;
+        running_ = static_cast<int>(threads_.size());
+    }
+    start_.notify_all();
+
+    drain(0);
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    finished_.wait(lock, [&] { return running_ == 0; });
+    job_ = nullptr;
+    for (int w = 0; w < workers(); ++w)
+    {
+        NodeLoad& node = node_load_[worker_node_[w]];
+        node.tasks        += queues_[w].done.tasks;
+        node.weight       += queues_[w].done.weight;
+        node.remote_tasks += queues_[w].done.remote_tasks;
+    }
+}
+
+void TileScheduler::workerLoop(int worker)
+{
+    if (numa_)
+        topology_.pinCurrentThread(worker_node_[worker]);
+
+    uint64_t seen = 0;
+    for (;;)
+    {
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            start_.wait(lock, [&] { return stopping_ || generation_ != seen; });
+            if (stopping_) return;
+            seen = generation_;
+        }
+        drain(worker);
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (--running_ == 0)
+                finished_.notify_one();
+        }
+    }
+}
+
+void TileScheduler::drain(int worker)
+{
+    uint32_t task;
+    while (take(worker, &task) || steal(worker, &task))
+        runTask(worker, task);
+}
+
+void TileScheduler::runTask(int worker, uint32_t task)
+{
+    (*job_)(task, worker);
+    NodeLoad& done = queues_[worker].done;
+    ++done.tasks;
+    done.weight += (*weights_)[task];
+    if (homes_ && (*homes_)[task] % nodes_ != worker_node_[worker])
+        ++done.remote_tasks;
+}
+
+bool TileScheduler::take(int worker, uint32_t* task)
+{
+    Queue& q = queues_[worker];
+    uint64_t b = q.bounds.load(std::memory_order_acquire);
+    for (;;)
+    {
+        const uint32_t head = static_cast<uint32_t>(b);
+        const uint32_t tail = static_cast<uint32_t>(b >> 32);
+        if (head >= tail) return false;
+        if (q.bounds.compare_exchange_weak(b, pack(head + 1, tail), std::memory_order_acq_rel))
+        {
+            *task = q.tasks[head];
+            return true;
+        }
+    }
+}
+
+bool TileScheduler::steal(int worker, uint32_t* task)
+{
+    // Victims in turn from the next worker on, so thieves spread out; the
+    // worker's own node first, then the rest.
+    const int n = workers();
+    for (int pass = 0; pass < (nodes_ > 1 ? 2 : 1); ++pass)
+    {
+        for (int k = 1; k < n; ++k)
+        {
+            const int victim = (worker + k) % n;
+            if (nodes_ > 1 && (worker_node_[victim] == worker_node_[worker]) != (pass == 0)) continue;
+            Queue& q = queues_[victim];
+            uint64_t b = q.bounds.load(std::memory_order_acquire);
+            for (;;)
+            {
+                const uint32_t head = static_cast<uint32_t>(b);
+                const uint32_t tail = static_cast<uint32_t>(b >> 32);
+                if (head >= tail) break;
+                if (q.bounds.compare_exchange_weak(b, pack(head, tail - 1), std::memory_order_acq_rel))
+                {
+                    *task = q.tasks[tail - 1];
+                    steals_.fetch_add(1, std::memory_order_relaxed);
+                    return true;
+                }
+            }
+        }
+    }
+    return false;
+}
@@ -0,0 +1,112 @@
+//
+//  tile_scheduler.hpp
+//  Volterria
+//
+//  Created by Devin R Cohen on 10/18/26.
+//
+
+#pragma once
+
+// TileScheduler: a small persistent worker pool for the Field's parallel
+// phases. A phase hands run() one weight per task (for perception, a
+// grid tile's occupancy); tasks are dealt heaviest first to whichever
+// worker has the least work so far, and a worker that runs dry steals
+// from the back of someone else's queue. So a population piled into a
+// few cells still keeps every worker busy.
+//
+// With a NumaTopology, workers are split into contiguous groups, one per
+// node, and pinned to that node's CPUs. Tasks can then carry a home node:
+// they are dealt only to that node's workers, and a dry worker steals
+// from its own node before crossing to another, so cross-node work is
+// limited to what actually needs rebalancing. nodeLoad() reports how the
+// last run() came out per node.
+//
+// The calling thread is worker 0 and run() returns once every task has
+// finished. Each queue is a fixed array plus one atomic word holding
+// (head, tail); the owner takes from the head and thieves from the tail,
+// both by compare-and-swap on that word, so a task is taken exactly once.
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "function_ref.hpp"
+#include "numa_topology.hpp"
+
+// Work done by one node's workers during a run().
+struct NodeLoad
+{
+    uint64_t tasks = 0;
+    uint64_t weight = 0;
+    uint64_t remote_tasks = 0; // of those, homed on another node
+};
+
+class TileScheduler
+{
+public:
+    // fn(task, worker): worker is in [0, workers()), for per-worker scratch.
+    // Only referenced for the duration of run(), so nothing is allocated.
+    using TaskFn = FunctionRef<void(std::size_t task, int worker)>;
+
+    // numa: pin workers per node (copied; may be null).
+    explicit TileScheduler(int workers, const NumaTopology* numa = nullptr);
+    ~TileScheduler();
+    TileScheduler(const TileScheduler&) = delete;
+    TileScheduler& operator=(const TileScheduler&) = delete;
+
+    int workers() const noexcept { return static_cast<int>(queues_.size()); }
+    int nodes() const noexcept { return nodes_; }
+    int nodeOf(int worker) const noexcept { return worker_node_[worker]; }
+    const NumaTopology* topology() const noexcept { return numa_ ? &topology_ : nullptr; }
+
+    // Run fn for every task in weights' index range; blocks until done.
+    // homes, if given, holds each task's node (taken modulo nodes()).
+    void run(const std::vector<uint32_t>& weights, TaskFn fn,
+             const std::vector<uint16_t>* homes = nullptr);
+
+    const std::vector<NodeLoad>& nodeLoad() const noexcept { return node_load_; }
+
+    // Tasks taken from another worker's queue over the last run().
+    std::size_t stealsLastRun() const noexcept { return steals_.load(std::memory_order_relaxed); }
+
+private:
+    struct alignas(64) Queue
+    {
+        std::vector<uint32_t> tasks;
+        std::atomic<uint64_t> bounds{0}; // head | tail << 32
+        NodeLoad done; // this worker's share of the run, kept off shared lines
+    };
+
+    static uint64_t pack(uint32_t head, uint32_t tail) noexcept { return head | (uint64_t(tail) << 32); }
+
+    void workerLoop(int worker);
+    void drain(int worker);
+    bool take(int worker, uint32_t* task);
+    bool steal(int worker, uint32_t* task);
+    void runTask(int worker, uint32_t task);
+
+    bool numa_ = false;
+    NumaTopology topology_;
+    int nodes_ = 1;
+    std::vector<int> worker_node_;
+    std::vector<Queue> queues_;
+    std::vector<std::thread> threads_;
+    std::vector<uint64_t> load_; // scratch for dealing tasks out
+    std::vector<uint32_t> order_; // likewise
+
+    std::mutex mutex_;
+    std::condition_variable start_;
+    std::condition_variable finished_;
+    const TaskFn* job_ = nullptr;
+    const std::vector<uint32_t>* weights_ = nullptr;
+    const std::vector<uint16_t>* homes_ = nullptr;
+    std::vector<NodeLoad> node_load_;
+    uint64_t generation_ = 0;
+    int running_ = 0; // helper threads still in this run
+    bool stopping_ = false;
+    std::atomic<std::size_t> steals_{0};
+};
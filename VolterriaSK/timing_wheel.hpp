@@ -0,0 +1,118 @@
+//
+//  timing_wheel.hpp
+//  Volterria
+//
+//  Created by Devin R Cohen on 10/18/26.
+//
+
+#pragma once
+
+// TimingWheel: hierarchical timer wheel over 32-bit ticks.
+// Four levels of 256 slots, one byte of the due tick each. An entry sits
+// on the level of the highest byte where its due tick still differs from
+// now; when now reaches that slot the entry is cascaded down a level, and
+// level 0 slots hold exactly the entries due on that tick. Scheduling is
+// O(1), and advancing costs a slot visit per tick plus the entries that
+// actually fire (or cascade), however many are waiting.
+//
+// There is no cancel: callers drop stale entries when they fire. Due
+// ticks are taken modulo 2^32, so nothing may be scheduled further out
+// than that.
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+template <typename T>
+class TimingWheel
+{
+public:
+    static constexpr int      kLevels    = 4;
+    static constexpr int      kSlotBits  = 8;
+    static constexpr uint32_t kSlots     = 1u << kSlotBits;
+    static constexpr uint32_t kSlotMask  = kSlots - 1;
+
+    // Drop everything and restart the clock at `now`.
+    void reset(uint32_t now)
+    {
+        for (auto& level : slots_)
+            for (auto& slot : level)
+                slot.clear();
+        overdue_.clear();
+        now_ = now;
+        size_ = 0;
+    }
+
+    // Anything due at or before now fires on the next advance().
+    void schedule(uint32_t due, const T& value)
+    {
+        ++size_;
+        if (due <= now_) overdue_.push_back({due, value});
+        else place({due, value});
+    }
+
+    // Move the clock to `to`, calling fire(due, value) for every entry that
+    // comes due along the way, in tick order. fire() may schedule more.
+    template <typename Fire>
+    void advance(uint32_t to, Fire&& fire)
+    {
+        if (!overdue_.empty())
+        {
+            scratch_.swap(overdue_);
+            for (const Entry& e : scratch_) { --size_; fire(e.due, e.value); }
+            scratch_.clear();
+        }
+        while (now_ < to)
+        {
+            if (size_ == 0) { now_ = to; return; }
+            ++now_;
+
+            // Cascade from the top so entries can fall through more than
+            // one level on the same tick.
+            for (int level = kLevels - 1; level > 0; --level)
+            {
+                const uint32_t low = now_ & ((1u << (kSlotBits * level)) - 1);
+                if (low != 0) continue;
+                auto& slot = slots_[level][(now_ >> (kSlotBits * level)) & kSlotMask];
+                if (slot.empty()) continue;
+                scratch_.swap(slot);
+                for (const Entry& e : scratch_) place(e);
+                scratch_.clear();
+            }
+
+            auto& slot = slots_[0][now_ & kSlotMask];
+            if (slot.empty()) continue;
+            scratch_.swap(slot);
+            for (const Entry& e : scratch_) { --size_; fire(e.due, e.value); }
+            scratch_.clear();
+        }
+    }
+
+    uint32_t now() const noexcept { return now_; }
+    std::size_t size() const noexcept { return size_; }
+    bool empty() const noexcept { return size_ == 0; }
+
+private:
+    struct Entry
+    {
+        uint32_t due;
+        T value;
+    };
+
+    // due >= now_; equal only while cascading, into the slot about to fire.
+    void place(const Entry& e)
+    {
+        const uint32_t diff = e.due ^ now_;
+        int level = 0;
+        while (level < kLevels - 1 && (diff >> (kSlotBits * (level + 1))) != 0)
+            ++level;
+        slots_[level][(e.due >> (kSlotBits * level)) & kSlotMask].push_back(e);
+    }
+
+    std::vector<Entry> slots_[kLevels][kSlots];
+    std::vector<Entry> overdue_;
+    std::vector<Entry> scratch_;
+    uint32_t now_ = 0;
+    std::size_t size_ = 0;
+};
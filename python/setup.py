@@ -0,0 +1,24 @@
+# Build the Python bindings in place:
+#   pip install pybind11 numpy
+#   python setup.py build_ext --inplace
+# then `import volterria` from this directory.
+
+from glob import glob
+
+from pybind11.setup_helpers import Pybind11Extension, build_ext
+from setuptools import setup
+
+ENGINE_SOURCES = sorted(glob("../VolterriaSK/*.cpp"))
+
+setup(
+    name="volterria",
+    ext_modules=[
+        Pybind11Extension(
+            "volterria",
+            ["volterria_module.cpp", *ENGINE_SOURCES],
+            include_dirs=["../VolterriaSK"],
+            cxx_std=20,
+        )
+    ],
+    cmdclass={"build_ext": build_ext},
+)
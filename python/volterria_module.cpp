@@ -0,0 +1,246 @@
+//
+//  volterria_module.cpp
+//  Volterria
+//
+//  Created by Devin R Cohen on 10/18/26.
+//
+
+// Python bindings for VolterriaEngine.
+// Bulk state is handed out as NumPy arrays that alias the engine's own
+// buffers (VEngineArrays and the grass raster) rather than copies, so a
+// sweep can step the engine and read positions / hunger / age / role /
+// grass health every frame without copying or materializing Python
+// objects per creature.
+//
+// The arrays are read-only views whose base is the engine, so the engine
+// outlives them, but its buffers do not hold still: refresh()
+// (refreshArrays()) rewrites and may reallocate the VEngineArrays, and
+// step() / run() rewrite the grass raster, which any reset, reconfigure,
+// resize or seek may also reallocate. Each of those invalidates the views
+// fetched before it: re-fetch after the call instead of holding on to old
+// arrays, and np.copy() anything that must outlive a step.
+
+#include <pybind11/pybind11.h>
+#include <pybind11/numpy.h>
+
+#include "VolterriaEngine.hpp"
+
+namespace py = pybind11;
+
+namespace
+{
+    // Wrap an engine-owned buffer without copying. `owner` becomes the
+    // array's base object, which keeps the engine alive while the view is.
+    template <typename T>
+    py::array_t<T> view(const std::vector<T>& buffer, std::vector<py::ssize_t> shape, py::handle owner)
+    {
+        py::array_t<T> out(shape, buffer.data(), owner);
+        out.attr("flags").attr("writeable") = false;
+        return out;
+    }
+
+    VolterriaEngine& engineOf(py::handle self)
+    {
+        return self.cast<VolterriaEngine&>();
+    }
+}
+
+PYBIND11_MODULE(volterria, m)
+{
+    m.doc() = "Volterria predator/prey simulation engine";
+
+    py::enum_<VSpeciesRole>(m, "SpeciesRole")
+        .value("Prey", VSpeciesRole::Prey)
+        .value("Predator", VSpeciesRole::Predator);
+
+    py::class_<Settings> settings(m, "Settings");
+    settings.def(py::init<>());
+#define VOLTERRIA_SETTING(name) settings.def_readwrite(#name, &Settings::name);
+    VOLTERRIA_SETTING(default_length)
+    VOLTERRIA_SETTING(height_ratio)
+    VOLTERRIA_SETTING(x_min)
+    VOLTERRIA_SETTING(x_max)
+    VOLTERRIA_SETTING(y_min)
+    VOLTERRIA_SETTING(y_max)
+    VOLTERRIA_SETTING(prey_spawn_mean_x)
+    VOLTERRIA_SETTING(prey_spawn_mean_y)
+    VOLTERRIA_SETTING(prey_spawn_stdev_n)
+    VOLTERRIA_SETTING(prey_spawn_stdev)
+    VOLTERRIA_SETTING(predator_spawn_mean_x)
+    VOLTERRIA_SETTING(predator_spawn_mean_y)
+    VOLTERRIA_SETTING(predator_spawn_stdev_n)
+    VOLTERRIA_SETTING(predator_spawn_stdev)
+    VOLTERRIA_SETTING(numprey)
+    VOLTERRIA_SETTING(numpred)
+    VOLTERRIA_SETTING(vmax_default)
+    VOLTERRIA_SETTING(accel_tick)
+    VOLTERRIA_SETTING(pred_hunger_threshold)
+    VOLTERRIA_SETTING(prey_hunger_threshold)
+    VOLTERRIA_SETTING(prey_hunger_restore_rate)
+    VOLTERRIA_SETTING(pred_libido_threshold)
+    VOLTERRIA_SETTING(prey_libido_threshold)
+    VOLTERRIA_SETTING(predator_hunt_speed_min)
+    VOLTERRIA_SETTING(predator_hunt_speed_max)
+    VOLTERRIA_SETTING(predator_hunt_max_accel)
+    VOLTERRIA_SETTING(prey_forage_speed_min)
+    VOLTERRIA_SETTING(prey_forage_speed_max)
+    VOLTERRIA_SETTING(prey_forage_max_accel)
+    VOLTERRIA_SETTING(prey_mate_speed_min)
+    VOLTERRIA_SETTING(prey_mate_speed_max)
+    VOLTERRIA_SETTING(prey_mate_max_accel)
+    VOLTERRIA_SETTING(predator_mate_speed_min)
+    VOLTERRIA_SETTING(predator_mate_speed_max)
+    VOLTERRIA_SETTING(predator_mate_max_accel)
+    VOLTERRIA_SETTING(hunger_tick_seconds)
+    VOLTERRIA_SETTING(prey_libido_rate)
+    VOLTERRIA_SETTING(pred_libido_rate)
+    VOLTERRIA_SETTING(prey_starve_rate)
+    VOLTERRIA_SETTING(pred_starve_rate)
+    VOLTERRIA_SETTING(interaction_radius)
+    VOLTERRIA_SETTING(prey_vision_radius)
+    VOLTERRIA_SETTING(predator_vision_radius)
+    VOLTERRIA_SETTING(interaction_multiplier)
+    VOLTERRIA_SETTING(auto_cell_size)
+    VOLTERRIA_SETTING(cell_retune_interval_steps)
+    VOLTERRIA_SETTING(sparse_grid)
+    VOLTERRIA_SETTING(neighbor_lists)
+    VOLTERRIA_SETTING(neighbor_skin)
+    VOLTERRIA_SETTING(perception_interval_steps)
+    VOLTERRIA_SETTING(perception_budget)
+    VOLTERRIA_SETTING(target_tracking)
+    VOLTERRIA_SETTING(target_refresh_steps)
+    VOLTERRIA_SETTING(event_timers)
+    VOLTERRIA_SETTING(timer_resolution)
+    VOLTERRIA_SETTING(mean_field_prey_capacity)
+    VOLTERRIA_SETTING(mean_field_max_population)
+    VOLTERRIA_SETTING(min_normalized_hunger_to_mate)
+    VOLTERRIA_SETTING(swept_interactions)
+    VOLTERRIA_SETTING(prevent_spirals)
+    VOLTERRIA_SETTING(batched_update)
+    VOLTERRIA_SETTING(worker_threads)
+    VOLTERRIA_SETTING(tile_cells)
+    VOLTERRIA_SETTING(tile_max_creatures)
+    VOLTERRIA_SETTING(numa_tiles)
+    VOLTERRIA_SETTING(segregate_species)
+    VOLTERRIA_SETTING(reorder_interval_steps)
+    VOLTERRIA_SETTING(prey_max_age)
+    VOLTERRIA_SETTING(pred_max_age)
+    VOLTERRIA_SETTING(age_variation_fraction)
+    VOLTERRIA_SETTING(grass_patch_rows)
+    VOLTERRIA_SETTING(grass_patch_cols)
+    VOLTERRIA_SETTING(grass_max_health)
+    VOLTERRIA_SETTING(grass_regrow_rate)
+    VOLTERRIA_SETTING(grass_radius_frac)
+    VOLTERRIA_SETTING(grass_eat_rate)
+    VOLTERRIA_SETTING(min_grass_edible_health)
+    VOLTERRIA_SETTING(grass_raster)
+    VOLTERRIA_SETTING(grass_raster_subdivisions)
+    VOLTERRIA_SETTING(grass_diffusion_rate)
+    VOLTERRIA_SETTING(probability_female_prey)
+    VOLTERRIA_SETTING(probability_female_pred)
+    VOLTERRIA_SETTING(rng_seed)
+    VOLTERRIA_SETTING(history_keyframe_interval)
+    VOLTERRIA_SETTING(history_budget_mb)
+#undef VOLTERRIA_SETTING
+    // Derived from the fields above; recompute_derived() (or handing the
+    // settings to an Engine) brings them up to date.
+    settings.def_readonly("cell_size", &Settings::cell_size);
+    settings.def_readonly("num_cells_x", &Settings::num_cells_x);
+    settings.def_readonly("num_cells_y", &Settings::num_cells_y);
+    settings.def("recompute_derived", &Settings::recomputeDerived);
+    settings.def("recenter_spawns", &Settings::recenterSpawns,
+                 "Reset the spawn distributions to the defaults for the current bounds.");
+
+    py::class_<VolterriaEngine>(m, "Engine")
+        .def(py::init<>())
+        .def(py::init<const Settings&>(), py::arg("settings"))
+        .def("reset", &VolterriaEngine::ResetSimulation)
+        .def("warm_reset", &VolterriaEngine::WarmReset,
+             "Reset without console output, reusing every buffer.")
+        .def("reconfigure", &VolterriaEngine::Reconfigure, py::arg("settings"),
+             "Apply new settings mid-run, keeping the population.")
+        .def("step", &VolterriaEngine::step, py::arg("dt"))
+        .def("run", [](VolterriaEngine& e, double dt, int steps) {
+                // Whole sweeps stay in C++; Python only sees the end state.
+                py::gil_scoped_release release;
+                for (int i = 0; i < steps; ++i)
+                    e.step(dt);
+            }, py::arg("dt"), py::arg("steps"))
+        .def("refresh", &VolterriaEngine::refreshArrays,
+             "Rewrite the engine-owned arrays from the current state.")
+        .def_property_readonly("settings", &VolterriaEngine::settings, py::return_value_policy::copy)
+        .def("set_default_population", &VolterriaEngine::SetDefaultPopulation, py::arg("prey"), py::arg("pred"))
+        .def("set_world_dimensions", &VolterriaEngine::SetWorldDimensions, py::arg("width"), py::arg("height"))
+        .def("seek", &VolterriaEngine::seekToStep, py::arg("step"),
+             "Rewind to a retained step; simulation resumes from there.")
+        .def("enable_shared_memory", &VolterriaEngine::EnableSharedMemory,
+             py::arg("name"), py::arg("max_creatures"), py::arg("max_grass_patches"),
+             "Publish every step into a POSIX shared-memory segment for other processes.")
+        .def("disable_shared_memory", &VolterriaEngine::DisableSharedMemory)
+        .def("begin_rate_fit", &VolterriaEngine::beginRateFit,
+             "Start the window fast_forward() fits its rates from.")
+        .def("fast_forward", [](VolterriaEngine& e, double seconds, double ode_step) {
+                // (n, 3) array of time, prey, predators; empty if there was nothing to fit.
+                const std::vector<VPopulationSample> curve = e.fastForward(seconds, ode_step);
+                py::array_t<double> out({(py::ssize_t)curve.size(), (py::ssize_t)3});
+                auto rows = out.mutable_unchecked<2>();
+                for (std::size_t i = 0; i < curve.size(); ++i)
+                {
+                    rows(i, 0) = curve[i].time;
+                    rows(i, 1) = curve[i].prey;
+                    rows(i, 2) = curve[i].predators;
+                }
+                return out;
+            }, py::arg("seconds"), py::arg("ode_step") = 0.05,
+             "Skip ahead on the fitted mean-field model, then resume agents at the predicted counts.")
+        .def_property_readonly("rate_fit_window", &VolterriaEngine::rateFitWindow)
+        .def_property_readonly("step_count", &VolterriaEngine::currentStep)
+        .def_property_readonly("oldest_step", &VolterriaEngine::oldestRetainedStep)
+        .def_property_readonly("sim_seconds", &VolterriaEngine::elapsedSimSeconds)
+        .def_property_readonly("pair_checks_per_frame", &VolterriaEngine::pairChecksPerFrame)
+        .def_property_readonly("grid_cell_size", &VolterriaEngine::gridCellSize)
+        .def_property_readonly("node_load", [](const VolterriaEngine& e) {
+                // (tasks, weight, remote_tasks) per NUMA node, last step
+                const auto loads = e.nodeLoad();
+                py::array_t<int64_t> out({(py::ssize_t)loads.size(), (py::ssize_t)3});
+                auto rows = out.mutable_unchecked<2>();
+                for (py::ssize_t i = 0; i < (py::ssize_t)loads.size(); ++i)
+                {
+                    rows(i, 0) = loads[i].tasks;
+                    rows(i, 1) = loads[i].weight;
+                    rows(i, 2) = loads[i].remoteTasks;
+                }
+                return out;
+            })
+        // Zero-copy views over VEngineArrays; call refresh() first.
+        .def_property_readonly("ids", [](py::object self) {
+                const auto& a = engineOf(self).arrays();
+                return view(a.id, {(py::ssize_t)a.id.size()}, self);
+            })
+        .def_property_readonly("positions", [](py::object self) {
+                const auto& a = engineOf(self).arrays();
+                return view(a.position, {(py::ssize_t)a.position.size() / 2, 2}, self);
+            })
+        .def_property_readonly("hunger", [](py::object self) {
+                const auto& a = engineOf(self).arrays();
+                return view(a.hunger, {(py::ssize_t)a.hunger.size()}, self);
+            })
+        .def_property_readonly("age", [](py::object self) {
+                const auto& a = engineOf(self).arrays();
+                return view(a.age, {(py::ssize_t)a.age.size()}, self);
+            })
+        .def_property_readonly("role", [](py::object self) {
+                const auto& a = engineOf(self).arrays();
+                return view(a.role, {(py::ssize_t)a.role.size()}, self);
+            })
+        .def_property_readonly("grass_health", [](py::object self) {
+                const auto& a = engineOf(self).arrays();
+                return view(a.grassHealth, {(py::ssize_t)a.grassHealth.size()}, self);
+            })
+        // (rows, cols) raster grass, live without refresh(); valid until the next step.
+        .def_property_readonly("grass_raster", [](py::object self) {
+                const VolterriaEngine& e = engineOf(self);
+                return view(e.grassRaster(), {(py::ssize_t)e.grassRasterRows(), (py::ssize_t)e.grassRasterCols()}, self);
+            })
+        .def_property_readonly("grass_raster_cell_size", &VolterriaEngine::grassRasterCellSize);
+}
@@ -0,0 +1,173 @@
+//
+//  domain_loopback_test.cpp
+//  Volterria
+//
+//  Created by Devin R Cohen on 10/18/26.
+//
+
+// Two DomainNodes side by side (a 2x1 decomposition) as threads over a
+// LoopbackTransport. Nobody is born or dies, so after every step:
+//   - each rank holds exactly its own creatures, no ghosts left behind;
+//   - each rank's population changed by exactly what it received minus
+//     what it sent, and the total is the initial population;
+//   - each rank adopted one ghost per neighbor creature within the halo
+//     at the start of the step, no more and no fewer.
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "domain.hpp"
+
+namespace
+{
+    constexpr int kTilesX = 2;
+    constexpr int kTilesY = 1;
+    constexpr int kSteps = 600;
+    constexpr float kDt = 1.0f / 60.0f;
+
+    Settings steadySettings()
+    {
+        Settings s;
+        s.rng_seed = 3;
+        s.prey_libido_rate = 0.0f;
+        s.pred_libido_rate = 0.0f;
+        s.prey_starve_rate = 0.0f;
+        s.pred_starve_rate = 0.0f;
+        s.pred_hunger_threshold = -1.0f;
+        s.prey_max_age = 1e9f;
+        s.pred_max_age = 1e9f;
+        // Short sight, so the halo is a band along the border rather than
+        // the whole world.
+        s.prey_vision_radius = 40.0f;
+        s.predator_vision_radius = 40.0f;
+        return s;
+    }
+
+    std::size_t livingCount(const DomainNode& node)
+    {
+        std::size_t n = 0;
+        for (const Creature& c : node.field().creatures())
+            n += c.isAlive() && !c.isGhost();
+        return n;
+    }
+
+    // Creatures of `from` that `to` should see as ghosts next step.
+    std::size_t ghostsFor(const DomainNode& to, const DomainNode& from, float halo)
+    {
+        std::size_t n = 0;
+        for (const Creature& c : from.field().creatures())
+            n += c.isAlive() && to.rect().distanceSquared(c.position()) <= halo * halo;
+        return n;
+    }
+
+    // Everything a node holds after a step must be its own, alive and
+    // inside its rectangle.
+    bool ownsOnly(const DomainNode& node, const DomainLayout& layout)
+    {
+        for (const Creature& c : node.field().creatures())
+        {
+            if (c.isGhost() || !c.isAlive() || layout.ownerOf(c.position()) != node.rank())
+                return false;
+        }
+        return true;
+    }
+}
+
+int main()
+{
+    const Settings settings = steadySettings();
+    const DomainLayout layout(settings, kTilesX, kTilesY);
+    const float halo = std::max({settings.predator_vision_radius, settings.prey_vision_radius,
+                                 settings.interaction_radius});
+
+    auto transports = LoopbackTransport::createGroup(layout.size());
+    std::vector<std::unique_ptr<DomainNode>> nodes;
+    for (auto& t : transports)
+        nodes.push_back(std::make_unique<DomainNode>(settings, kTilesX, kTilesY, std::move(t)));
+    for (auto& node : nodes)
+        node->reset();
+
+    std::size_t total = 0;
+    for (const auto& node : nodes)
+        total += livingCount(*node);
+    const std::size_t expected_total = static_cast<std::size_t>(settings.numprey + settings.numpred);
+    if (total != expected_total)
+    {
+        std::printf("FAIL: reset split %zu creatures into %zu\n", expected_total, total);
+        return EXIT_FAILURE;
+    }
+
+    std::size_t migrants = 0;
+    std::size_t ghosts = 0;
+    for (int step = 0; step < kSteps; ++step)
+    {
+        std::vector<std::size_t> before(nodes.size());
+        std::vector<std::size_t> expected_ghosts(nodes.size(), 0);
+        for (std::size_t r = 0; r < nodes.size(); ++r)
+        {
+            before[r] = livingCount(*nodes[r]);
+            for (int peer : nodes[r]->neighbors())
+                expected_ghosts[r] += ghostsFor(*nodes[r], *nodes[peer], halo);
+        }
+
+        std::vector<char> ok(nodes.size(), 0);
+        std::vector<std::thread> threads;
+        for (std::size_t r = 0; r < nodes.size(); ++r)
+            threads.emplace_back([&, r] { ok[r] = nodes[r]->step(kDt); });
+        for (std::thread& t : threads)
+            t.join();
+
+        std::size_t after_total = 0;
+        for (std::size_t r = 0; r < nodes.size(); ++r)
+        {
+            const DomainNode& node = *nodes[r];
+            std::size_t received = 0;
+            for (int peer : node.neighbors())
+                received += nodes[peer]->migrantsLastStep();
+            const std::size_t after = livingCount(node);
+            after_total += after;
+
+            if (!ok[r])
+            {
+                std::printf("FAIL: step %d: rank %zu's transport failed\n", step, r);
+                return EXIT_FAILURE;
+            }
+            if (!ownsOnly(node, layout))
+            {
+                std::printf("FAIL: step %d: rank %zu holds a ghost or a creature it doesn't own\n", step, r);
+                return EXIT_FAILURE;
+            }
+            if (after != before[r] - node.migrantsLastStep() + received)
+            {
+                std::printf("FAIL: step %d: rank %zu went from %zu to %zu, sending %zu and receiving %zu\n",
+                            step, r, before[r], after, node.migrantsLastStep(), received);
+                return EXIT_FAILURE;
+            }
+            if (node.ghostsLastStep() != expected_ghosts[r])
+            {
+                std::printf("FAIL: step %d: rank %zu adopted %zu ghosts, expected %zu\n",
+                            step, r, node.ghostsLastStep(), expected_ghosts[r]);
+                return EXIT_FAILURE;
+            }
+            migrants += node.migrantsLastStep();
+            ghosts += node.ghostsLastStep();
+        }
+        if (after_total != total)
+        {
+            std::printf("FAIL: step %d: population %zu, expected %zu\n", step, after_total, total);
+            return EXIT_FAILURE;
+        }
+    }
+
+    if (migrants == 0 || ghosts == 0)
+    {
+        std::printf("FAIL: nothing crossed the border (%zu migrants, %zu ghosts)\n", migrants, ghosts);
+        return EXIT_FAILURE;
+    }
+    std::printf("PASS: %d steps, %zu creatures, %zu migrants, %zu ghosts\n", kSteps, total, migrants, ghosts);
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,129 @@
+//
+//  frame_arena_alloc_test.cpp
+//  Volterria
+//
+//  Created by Devin R Cohen on 10/18/26.
+//
+
+// Once warmed up, a step() plus refreshSnapshots() must not touch the
+// heap: per-step scratch comes from the FrameArena and every persistent
+// buffer keeps its capacity. Replaces the global allocation functions to
+// count calls, warms an engine up, then fails if any of N further steps
+// allocated.
+//
+// The population is held constant (no births, no starvation, no old age,
+// predators never hungry): a growing population legitimately grows
+// buffers, which is capacity growth, not a per-step allocation. Cell
+// membership vectors still grow while creatures wander into ever-busier
+// cells, so the warm-up is long enough for every cell to have seen its
+// peak. The storage reorder is switched on so its steps are measured too.
+
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+
+#include "VolterriaEngine.hpp"
+
+namespace
+{
+    std::atomic<long> allocations{0};
+
+    void* allocate(std::size_t bytes, std::size_t alignment)
+    {
+        allocations.fetch_add(1, std::memory_order_relaxed);
+        void* p = alignment > alignof(std::max_align_t)
+            ? std::aligned_alloc(alignment, (bytes + alignment - 1) / alignment * alignment)
+            : std::malloc(bytes ? bytes : 1);
+        if (!p) throw std::bad_alloc();
+        return p;
+    }
+}
+
+void* operator new(std::size_t bytes) { return allocate(bytes, 0); }
+void* operator new[](std::size_t bytes) { return allocate(bytes, 0); }
+void* operator new(std::size_t bytes, std::align_val_t a) { return allocate(bytes, static_cast<std::size_t>(a)); }
+void* operator new[](std::size_t bytes, std::align_val_t a) { return allocate(bytes, static_cast<std::size_t>(a)); }
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t) noexcept { std::free(p); }
+void operator delete(void* p, std::align_val_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::align_val_t) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t, std::align_val_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t, std::align_val_t) noexcept { std::free(p); }
+
+namespace
+{
+    constexpr int kWarmupSteps = 1000;
+    constexpr int kMeasuredSteps = 300;
+    constexpr double kDt = 1.0 / 60.0;
+
+    Settings steadySettings(int workers)
+    {
+        Settings s;
+        s.rng_seed = 1;
+        s.worker_threads = workers;
+        s.reorder_interval_steps = 64;
+        s.prey_libido_rate = 0.0f;
+        s.pred_libido_rate = 0.0f;
+        s.prey_starve_rate = 0.0f;
+        s.pred_starve_rate = 0.0f;
+        s.pred_hunger_threshold = -1.0f;
+        s.prey_max_age = 1e9f;
+        s.pred_max_age = 1e9f;
+        return s;
+    }
+
+    // Returns how many of the measured steps allocated.
+    int run(const char* name, const Settings& settings)
+    {
+        VolterriaEngine engine(settings);
+        engine.ResetSimulation();
+        const std::size_t population = engine.creatureSnapshot().size();
+        if (population == 0)
+        {
+            std::printf("%s: nothing spawned\n", name);
+            return kMeasuredSteps;
+        }
+        for (int i = 0; i < kWarmupSteps; ++i)
+        {
+            engine.step(kDt);
+            engine.refreshSnapshots();
+        }
+
+        int dirty_steps = 0;
+        long total = 0;
+        for (int i = 0; i < kMeasuredSteps; ++i)
+        {
+            const long before = allocations.load(std::memory_order_relaxed);
+            engine.step(kDt);
+            engine.refreshSnapshots();
+            const long made = allocations.load(std::memory_order_relaxed) - before;
+            if (made != 0)
+                ++dirty_steps;
+            total += made;
+        }
+        std::printf("%s: %zu creatures, %d/%d steps allocated (%ld allocations)\n",
+                    name, population, dirty_steps, kMeasuredSteps, total);
+        return dirty_steps;
+    }
+}
+
+int main()
+{
+    int failures = 0;
+    failures += run("serial", steadySettings(1)) != 0;
+    failures += run("4 workers", steadySettings(4)) != 0;
+
+    Settings scalar = steadySettings(1);
+    scalar.batched_update = false;
+    failures += run("scalar update", scalar) != 0;
+
+    Settings numa = steadySettings(4);
+    numa.numa_tiles = true;
+    failures += run("numa tiles", numa) != 0;
+
+    std::printf(failures ? "FAIL\n" : "PASS\n");
+    return failures ? EXIT_FAILURE : EXIT_SUCCESS;
+}
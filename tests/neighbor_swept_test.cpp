@@ -0,0 +1,39 @@
+//
+//  neighbor_swept_test.cpp
+//  Volterria
+//
+//  Created by Devin R Cohen on 10/18/26.
+//
+
+// Neighbor lists and swept interactions together. A list can still hold
+// handles of creatures that died after it was built; the pair pass must
+// skip them rather than index with their -1. Build with
+// -D_GLIBCXX_ASSERTIONS (the Makefile does) so a stray index aborts
+// instead of reading past the buffers.
+
+#include <cstdio>
+#include <cstdlib>
+
+#include "VolterriaEngine.hpp"
+
+int main()
+{
+    Settings settings;
+    settings.rng_seed = 7;
+    settings.neighbor_lists = true;
+    settings.neighbor_skin = 200.0f;
+    settings.swept_interactions = true;
+
+    VolterriaEngine engine(settings);
+    engine.ResetSimulation();
+    if (engine.creatureSnapshot().empty())
+    {
+        std::printf("FAIL: nothing spawned\n");
+        return EXIT_FAILURE;
+    }
+    for (int i = 0; i < 3000; ++i)
+        engine.step(1.0 / 60.0);
+
+    std::printf("PASS: 3000 steps, %zu creatures left\n", engine.creatureSnapshot().size());
+    return EXIT_SUCCESS;
+}